@@ -48,6 +48,22 @@
 
 struct Demo : public Component
 {
+    /** An Identifier is a string that has been "interned": every Identifier
+        made from the same text points to the same shared string, so comparing
+        two of them is as fast as comparing two pointers.
+
+        Creating an Identifier from a string literal has to look up that shared
+        string, though. If we make our Identifier once up front, looking up the
+        property while painting is just a quick scan through a few pointers.
+
+        https://docs.juce.com/master/classIdentifier.html
+    **/
+    static const Identifier& getGreetingId()
+    {
+        static const Identifier greetingId("Greeting");
+        return greetingId;
+    }
+
     Demo()
     {
         /** A Component can be given a name and ID to use for identification,
@@ -82,7 +98,7 @@ struct Demo : public Component
             be set to any type available in juce::var.
         **/
         #if 1 // change to 0 to remove the initial greeting
-          getProperties().set("Greeting", "Hello world, ");
+          getProperties().set(getGreetingId(), "Hello world, ");
         #endif
 
         /** ================================================================ **/
@@ -92,6 +108,54 @@ struct Demo : public Component
             since our component is made to take up the whole window.
         **/
         setSize(500, 500);
+
+        #if 0 // change to 1 to time property lookups
+          timePropertyLookups(1);
+          timePropertyLookups(16);
+          timePropertyLookups(256);
+        #endif
+    }
+
+    /** Looks up the last of the given number of properties 1,000,000 times,
+        first by creating the Identifier from a string each time, then using
+        an Identifier that was created up front, and logs the timings.
+
+        The checksum is part of the message so that the compiler can't throw
+        away the loops as unused work.
+    **/
+    static void timePropertyLookups(const int numProperties)
+    {
+        NamedValueSet properties;
+
+        for (int i = 0; i < numProperties; ++i)
+            properties.set("Property" + String(i), i);
+
+        const String name = "Property" + String(numProperties - 1);
+        const Identifier id(name);
+
+        const int numIterations = 1000000;
+        int checksum = 0;
+
+        double startTime = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numIterations; ++i)
+            checksum += (int)properties[Identifier(name)];
+
+        const double stringTime = Time::getMillisecondCounterHiRes() - startTime;
+
+        startTime = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numIterations; ++i)
+            checksum += (int)properties[id];
+
+        const double idTime = Time::getMillisecondCounterHiRes() - startTime;
+
+        Logger::writeToLog(
+            String(numProperties) + " properties: "
+                + String(stringTime, 2) + "ms from strings, "
+                + String(idTime, 2) + "ms from an Identifier"
+                + " (checksum " + String(checksum) + ")"
+        );
     }
 
     /** ==================================================================== **/
@@ -145,7 +209,7 @@ struct Demo : public Component
             string representation. We'll set our text variable to this to begin
             our sentence.
         **/
-        String text = getProperties()["Greeting"].toString();
+        String text = getProperties()[getGreetingId()].toString();
 
         /** We can construct the rest of the sentence by stating the name of the
             component, which we previously set in the constructor.
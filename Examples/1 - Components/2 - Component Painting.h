@@ -46,12 +46,159 @@
 
 #pragma once
 
+/** PaintStats keeps count of how often each Component has been painted, how
+    long it took, and how many pixels it covered. The counters are looked up
+    using the Component's ID, so they can be queried from anywhere.
+
+    When isEnabled is false, timing a paint costs a single check.
+**/
+struct PaintStats
+{
+    struct Counters
+    {
+        int64  paintCount  = 0;
+        int64  paintedArea = 0;
+        double totalTime   = 0.0;
+        double recentTime  = 0.0; // rolling average of the last few paints
+    };
+
+    bool isEnabled = true;
+
+    HashMap<String, Counters> counters;
+
+    static PaintStats& getInstance()
+    {
+        static PaintStats paintStats;
+        return paintStats;
+    }
+
+    void add(const String &name, const double time, const int64 area)
+    {
+        Counters &c = counters.getReference(name);
+
+        c.paintCount  += 1;
+        c.paintedArea += area;
+        c.totalTime   += time;
+        c.recentTime  += (time - c.recentTime) * 0.1;
+    }
+
+    /** Returns the counters for one of a Component's paint methods. **/
+    Counters get(const String &componentId, const String &method) const
+    {
+        return counters[componentId + "::" + method];
+    }
+
+    /** Returns the counters for all of a Component's paint methods added
+        together.
+    **/
+    Counters get(const String &componentId) const
+    {
+        const String prefix = componentId + "::";
+        Counters total;
+
+        for (HashMap<String, Counters>::Iterator i(counters); i.next();)
+        {
+            if (!i.getKey().startsWith(prefix))
+                continue;
+
+            const Counters &c = i.getValue();
+
+            total.paintCount  += c.paintCount;
+            total.paintedArea += c.paintedArea;
+            total.totalTime   += c.totalTime;
+            total.recentTime  += c.recentTime;
+        }
+
+        return total;
+    }
+
+    /** Returns a table of every Component's counters, with the Components
+        that have taken the most time in total at the top.
+    **/
+    String getTable() const
+    {
+        using Row = std::pair<String, Counters>;
+
+        Array<Row> rows;
+
+        for (HashMap<String, Counters>::Iterator i(counters); i.next();)
+            rows.add(std::make_pair(i.getKey(), i.getValue()));
+
+        std::sort(rows.begin(), rows.end(), [](const Row &a, const Row &b)
+        {
+            return a.second.totalTime > b.second.totalTime;
+        });
+
+        String table;
+
+        for (const Row &row : rows)
+        {
+            table << row.first.paddedRight(' ', 32)
+                  << String(row.second.paintCount).paddedLeft(' ', 8)
+                  << " paints"
+                  << String(row.second.totalTime, 3).paddedLeft(' ', 12)
+                  << "ms total"
+                  << String(row.second.recentTime, 3).paddedLeft(' ', 10)
+                  << "ms recent"
+                  << String(row.second.paintedArea).paddedLeft(' ', 12)
+                  << "px" << newLine;
+        }
+
+        return table;
+    }
+
+    /** ==================================================================== **/
+
+    /** Times a paint method from the moment it is created until it goes out
+        of scope, and adds the result to the counters.
+    **/
+    struct ScopedTimer
+    {
+        const Component &component;
+        const char *method;
+        int64 area = 0;
+        double startTime = 0.0;
+
+        ScopedTimer(const Component &c, const Graphics &g, const char *m)
+            : component(c), method(m)
+        {
+            if (getInstance().isEnabled)
+            {
+                const Rectangle<int> clip = g.getClipBounds();
+                area = (int64)clip.getWidth() * clip.getHeight();
+                startTime = Time::getMillisecondCounterHiRes();
+            }
+        }
+
+        ~ScopedTimer()
+        {
+            if (startTime > 0.0)
+            {
+                getInstance().add(
+                    component.getComponentID() + "::" + method,
+                    Time::getMillisecondCounterHiRes() - startTime,
+                    area
+                );
+            }
+        }
+    };
+};
+
+/** ======================================================================== **/
+
 struct Square : public Component
 {
     Colour colour;
 
+    Square()
+    {
+        setComponentID("Square");
+    }
+
     void paint(Graphics &g) override
     {
+        PaintStats::ScopedTimer timer(*this, g, "paint");
+
         g.fillAll(colour);
     }
 };
@@ -70,6 +217,7 @@ struct Demo : public Component
 
     Demo()
     {
+        setComponentID("DemoComponent");
         setSize(500, 500);
 
         square.colour = Colours::palevioletred;
@@ -84,6 +232,8 @@ struct Demo : public Component
     **/
     void paint(Graphics &g) override
     {
+        PaintStats::ScopedTimer timer(*this, g, "paint");
+
         g.setColour(Colours::skyblue);
         g.fillRect(getLocalBounds().reduced(50));
     }
@@ -96,8 +246,24 @@ struct Demo : public Component
     **/
     void paintOverChildren(Graphics &g) override
     {
+        PaintStats::ScopedTimer timer(*this, g, "paintOverChildren");
+
         g.setColour(Colours::white);
         g.drawText("Hello World!", square.getBounds(), Justification::centred);
     }
+
+    /** ==================================================================== **/
+
+    /** Click outside the square to log the paint statistics so far. You can
+        also look up a Component's counters by its ID, either for all of its
+        paint methods or just one of them, e.g.
+
+            PaintStats::getInstance().get("DemoComponent")
+            PaintStats::getInstance().get("DemoComponent", "paint")
+    **/
+    void mouseDown(const MouseEvent &e) override
+    {
+        Logger::writeToLog(PaintStats::getInstance().getTable());
+    }
 };
 
@@ -0,0 +1,318 @@
+/*******************************************************************************
+ The block below describes the properties of this PIP. A PIP is a short snippet
+ of code that can be read by the Projucer and used to generate a JUCE project.
+
+ BEGIN_JUCE_PIP_METADATA
+
+  name:             Hit Testing
+  vendor:           Antonio Lassandro
+  website:          https://www.github.com/lassandroan/juce-graphics-workshop
+  description:      Finding the Component under the mouse in large hierarchies
+
+  dependencies:     juce_core, juce_gui_basics
+  exporters:        linux_make, vs2013, vs2015, vs2017, vs2019, xcode_mac
+
+  moduleFlags:      JUCE_STRICT_REFCOUNTEDPOINTER=1
+
+  type:             Component
+  mainClass:        Demo
+
+ END_JUCE_PIP_METADATA
+
+*******************************************************************************/
+
+/*
+  Author: Antonio Lassandro
+  Copyright 2019 Harrison Consoles
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+/** By default a Component is hit-tested as a rectangle, so the mouse counts
+    as being over our round Knob even when it's in one of the corners.
+
+    We could check Path::contains() in hitTest(), but that has to walk the
+    whole Path for every mouse event. Instead, whenever the Knob changes size
+    we work out which pixels are inside the shape and store them as a mask
+    with one bit per pixel. Each hit-test is then a single bit lookup.
+**/
+struct Knob : public Component
+{
+    bool isHovered = false;
+
+    Path shape;
+
+    HeapBlock<uint32> mask;
+    int wordsPerRow = 0;
+
+    void resized() override
+    {
+        shape.clear();
+        shape.addEllipse(getLocalBounds().toFloat());
+
+        wordsPerRow = (getWidth() + 31) / 32;
+        mask.calloc((size_t)(wordsPerRow * getHeight()));
+
+        /** We test the centre of each pixel against the shape. **/
+        for (int y = 0; y < getHeight(); ++y)
+        {
+            for (int x = 0; x < getWidth(); ++x)
+            {
+                if (shape.contains(x + 0.5f, y + 0.5f))
+                    mask[y * wordsPerRow + x / 32] |= (uint32)1 << (x % 32);
+            }
+        }
+    }
+
+    bool hitTest(int x, int y) override
+    {
+        if (!isPositiveAndBelow(x, getWidth())
+            || !isPositiveAndBelow(y, getHeight()))
+            return false;
+
+        #if 1 // change to 0 to test against the Path itself
+          return ((mask[y * wordsPerRow + x / 32] >> (x % 32)) & 1) != 0;
+        #else
+          return shape.contains(x + 0.5f, y + 0.5f);
+        #endif
+    }
+
+    void paint(Graphics &g) override
+    {
+        g.setColour(isHovered ? Colours::white : Colours::skyblue);
+        g.fillPath(shape);
+    }
+};
+
+/** ======================================================================== **/
+
+/** When the mouse moves, JUCE finds the Component underneath it by asking each
+    child, from front to back, whether it contains the mouse position. With
+    thousands of children that means thousands of checks on every mouse move.
+
+    A KnobField splits its area into a grid of cells and keeps a list of the
+    Knobs that overlap each cell. To find the Knob under the mouse we only need
+    to check the few Knobs in a single cell.
+
+    The grid is only rebuilt when it is needed after a Knob has been moved or
+    resized.
+**/
+struct KnobField : public Component
+{
+    static constexpr int CellSize = 20;
+
+    OwnedArray<Knob> knobs;
+
+    Array<Array<Knob*>> cells;
+    int numColumns = 0;
+    int numRows    = 0;
+
+    bool isIndexValid = false;
+
+    void childBoundsChanged(Component *child) override
+    {
+        isIndexValid = false;
+    }
+
+    void resized() override
+    {
+        isIndexValid = false;
+    }
+
+    void rebuildIndex()
+    {
+        numColumns = jmax(1, (getWidth()  + CellSize - 1) / CellSize);
+        numRows    = jmax(1, (getHeight() + CellSize - 1) / CellSize);
+
+        cells.clearQuick();
+        cells.resize(numColumns * numRows);
+
+        /** Knobs are added to each cell in back-to-front order, the same
+            order as our children.
+        **/
+        for (Knob * const knob : knobs)
+        {
+            const Rectangle<int> bounds = knob->getBounds()
+                .getIntersection(getLocalBounds());
+
+            if (bounds.isEmpty())
+                continue;
+
+            const int firstColumn = bounds.getX() / CellSize;
+            const int lastColumn  = (bounds.getRight() - 1) / CellSize;
+            const int firstRow    = bounds.getY() / CellSize;
+            const int lastRow     = (bounds.getBottom() - 1) / CellSize;
+
+            for (int row = firstRow; row <= lastRow; ++row)
+                for (int column = firstColumn; column <= lastColumn; ++column)
+                    cells.getReference(row * numColumns + column).add(knob);
+        }
+
+        isIndexValid = true;
+    }
+
+    static bool isKnobAt(Knob &knob, const Point<int> &position)
+    {
+        const Point<int> localPosition = position - knob.getPosition();
+
+        return knob.isVisible()
+            && knob.getLocalBounds().contains(localPosition)
+            && knob.hitTest(localPosition.x, localPosition.y);
+    }
+
+    /** Returns the front-most Knob at the given position, or nullptr. We
+        search from the front-most Knob to the back-most.
+    **/
+    Knob* getKnobAt(const Point<int> &position)
+    {
+        if (!getLocalBounds().contains(position))
+            return nullptr;
+
+        #if 1 // change to 0 to check every Knob instead of using the grid
+          if (!isIndexValid)
+              rebuildIndex();
+
+          const Array<Knob*> &cell = cells.getReference(
+              (position.y / CellSize) * numColumns + (position.x / CellSize)
+          );
+
+          for (int i = cell.size(); --i >= 0;)
+          {
+              if (isKnobAt(*cell.getUnchecked(i), position))
+                  return cell.getUnchecked(i);
+          }
+        #else
+          for (int i = knobs.size(); --i >= 0;)
+          {
+              if (isKnobAt(*knobs.getUnchecked(i), position))
+                  return knobs.getUnchecked(i);
+          }
+        #endif
+
+        return nullptr;
+    }
+};
+
+/** ======================================================================== **/
+
+struct Demo : public Component
+{
+    static constexpr int KnobSize = 10;
+
+    KnobField field;
+    Knob *hoveredKnob = nullptr;
+
+    double totalLookupTime = 0.0;
+    int numLookups = 0;
+
+    Demo()
+    {
+        /** Try changing the size of the Knobs to change how many there are,
+            and compare the lookup time with and without the grid.
+        **/
+        for (int y = 0; y < 450; y += KnobSize)
+        {
+            for (int x = 0; x < 500; x += KnobSize)
+            {
+                Knob * const knob = field.knobs.add(new Knob());
+                knob->setBounds(x, y, KnobSize, KnobSize);
+                field.addAndMakeVisible(knob);
+            }
+        }
+
+        /** When a Component doesn't intercept mouse clicks, and doesn't allow
+            its children to either, JUCE won't look at any of its children when
+            searching for the Component under the mouse. All the mouse events
+            will come to the Demo instead, and we use the KnobField's grid to
+            find the Knob.
+        **/
+        field.setInterceptsMouseClicks(false, false);
+        addAndMakeVisible(field);
+
+        setSize(500, 500);
+    }
+
+    /** ==================================================================== **/
+
+    void resized() override
+    {
+        field.setBounds(getLocalBounds().withTrimmedBottom(50));
+    }
+
+    void mouseMove(const MouseEvent &e) override
+    {
+        const double startTime = Time::getMillisecondCounterHiRes();
+
+        Knob * const knob = field.getKnobAt(
+            e.getPosition() - field.getPosition()
+        );
+
+        totalLookupTime += Time::getMillisecondCounterHiRes() - startTime;
+        ++numLookups;
+
+        if (knob != hoveredKnob)
+        {
+            if (hoveredKnob != nullptr)
+            {
+                hoveredKnob->isHovered = false;
+                hoveredKnob->repaint();
+            }
+
+            if (knob != nullptr)
+            {
+                knob->isHovered = true;
+                knob->repaint();
+            }
+
+            hoveredKnob = knob;
+        }
+
+        repaint(getLocalBounds().removeFromBottom(50));
+    }
+
+    void mouseExit(const MouseEvent &e) override
+    {
+        if (hoveredKnob != nullptr)
+        {
+            hoveredKnob->isHovered = false;
+            hoveredKnob->repaint();
+            hoveredKnob = nullptr;
+        }
+    }
+
+    void paint(Graphics &g) override
+    {
+        g.fillAll(findColour(ResizableWindow::backgroundColourId));
+
+        const double averageTime = numLookups > 0
+            ? totalLookupTime / numLookups
+            : 0.0;
+
+        g.setColour(Colours::white);
+        g.setFont(16.0f);
+        g.drawText(
+            String(field.knobs.size()) + " knobs, average lookup: "
+                + String(averageTime * 1000.0, 2) + "us",
+            getLocalBounds().removeFromBottom(50),
+            Justification::centred
+        );
+    }
+};
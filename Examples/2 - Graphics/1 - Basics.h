@@ -108,6 +108,75 @@ struct Demo : public Component
 
         addAndMakeVisible(square);
         square.centreWithSize(250, 250);
+
+        /** ================================================================ **/
+
+        /** Rather than deciding by hand, we can paint a component into an
+            Image and check whether it covered every pixel.
+        **/
+        #if 0 // change to 1 to find out automatically whether square is opaque
+          square.setOpaque(paintsOpaquely(square));
+
+          setName("Demo");
+          square.setName("Square");
+          reportComponentsThatCouldBeOpaque(*this);
+        #endif
+    }
+
+    /** ==================================================================== **/
+
+    /** Takes a snapshot of the component (and its children), then checks
+        whether every pixel in it ended up fully opaque.
+
+        This only tells us about a single paint, so it's only reliable for
+        components that always cover the same area when they paint. Our square
+        paints a different colour each time, but always the same ellipse.
+
+        https://docs.juce.com/master/classComponent.html
+    **/
+    static bool paintsOpaquely(Component &component)
+    {
+        if (component.getWidth() <= 0 || component.getHeight() <= 0)
+            return false;
+
+        /** The snapshot starts out transparent, unless the component is
+            already marked as opaque - then it has no alpha channel at all.
+        **/
+        const Image image = component.createComponentSnapshot(
+            component.getLocalBounds()
+        );
+
+        if (!image.isARGB())
+            return true;
+
+        const Image::BitmapData data(image, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < data.height; ++y)
+        {
+            const uint8 *pixel = data.getLinePointer(y);
+
+            for (int x = 0; x < data.width; ++x, pixel += data.pixelStride)
+            {
+                if (reinterpret_cast<const PixelARGB*>(pixel)->getAlpha() < 255)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    /** Logs the name of every component in the hierarchy that paints its
+        whole area but isn't marked as opaque.
+    **/
+    static void reportComponentsThatCouldBeOpaque(Component &component)
+    {
+        if (!component.isOpaque() && paintsOpaquely(component))
+        {
+            Logger::writeToLog("Could be opaque: " + component.getName());
+        }
+
+        for (Component * const child : component.getChildren())
+            reportComponentsThatCouldBeOpaque(*child);
     }
 
     /** ==================================================================== **/
@@ -0,0 +1,490 @@
+/*******************************************************************************
+ The block below describes the properties of this PIP. A PIP is a short snippet
+ of code that can be read by the Projucer and used to generate a JUCE project.
+
+ BEGIN_JUCE_PIP_METADATA
+
+  name:             Coverage Rasteriser
+  vendor:           Antonio Lassandro
+  website:          https://www.github.com/lassandroan/juce-graphics-workshop
+  description:      Fills paths using the exact area they cover in each pixel
+
+  dependencies:     juce_core, juce_gui_basics
+  exporters:        linux_make, vs2013, vs2015, vs2017, vs2019, xcode_mac
+
+  moduleFlags:      JUCE_STRICT_REFCOUNTEDPOINTER=1
+
+  type:             Component
+  mainClass:        Demo
+
+ END_JUCE_PIP_METADATA
+
+*******************************************************************************/
+
+/*
+  Author: Antonio Lassandro
+  Copyright 2019 Harrison Consoles
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+/** An alternative to the rasteriser that Graphics::fillPath() uses.
+
+    JUCE turns a Path into an EdgeTable, which samples each pixel row at a few
+    fixed vertical positions and counts how much of each sample is inside the
+    shape. This rasteriser works out the exact area of each pixel that is
+    covered instead.
+
+    Every line in the flattened Path adds the signed area it covers to the
+    cells of the rows it crosses. Once every line has been added, summing each
+    row from left to right gives the coverage of every pixel in that row.
+
+    Paths use the non-zero winding rule and are expected to fit inside the
+    image - anything outside is squashed against its edges.
+**/
+struct CoverageRasteriser
+{
+    int width  = 0;
+    int height = 0;
+
+    /** One float per pixel, plus two spare cells at the end of each row for
+        lines that touch the right hand edge.
+    **/
+    HeapBlock<float> cells;
+
+    void setSize(const int newWidth, const int newHeight)
+    {
+        width  = newWidth;
+        height = newHeight;
+
+        cells.calloc((size_t)((width + 2) * height));
+    }
+
+    /** ==================================================================== **/
+
+    void addLine(Point<float> start, Point<float> end)
+    {
+        if (start.y == end.y)
+            return;
+
+        /** Lines going up the image take away from the coverage, lines going
+            down add to it.
+        **/
+        float direction = 1.0f;
+
+        if (start.y > end.y)
+        {
+            std::swap(start, end);
+            direction = -1.0f;
+        }
+
+        const float dxdy = (end.x - start.x) / (end.y - start.y);
+
+        float x = start.x;
+
+        if (start.y < 0.0f)
+            x -= start.y * dxdy;
+
+        const int firstRow = jmax(0, (int)start.y);
+        const int lastRow  = jmin(height, (int)std::ceil(end.y));
+
+        for (int y = firstRow; y < lastRow; ++y)
+        {
+            float * const row = cells + y * (width + 2);
+
+            const float dy = jmin((float)(y + 1), end.y)
+                - jmax((float)y, start.y);
+
+            const float xNext = x + dxdy * dy;
+            const float area  = dy * direction;
+
+            const float x0 = jlimit(0.0f, (float)width, jmin(x, xNext));
+            const float x1 = jlimit(0.0f, (float)width, jmax(x, xNext));
+
+            const float x0Floor = std::floor(x0);
+            const float x1Ceil  = std::ceil(x1);
+
+            const int x0Index = (int)x0Floor;
+            const int x1Index = (int)x1Ceil;
+
+            if (x1Index <= x0Index + 1)
+            {
+                /** The line stays within one pixel on this row, so it's split
+                    between that pixel and the one after it.
+                **/
+                const float middle = 0.5f * (x0 + x1) - x0Floor;
+
+                row[x0Index]     += area - area * middle;
+                row[x0Index + 1] += area * middle;
+            }
+            else
+            {
+                /** The line crosses several pixels. The first and last pixels
+                    get the triangles cut off by the line, and the pixels
+                    between them get an equal share of the rest.
+                **/
+                const float scale = 1.0f / (x1 - x0);
+
+                const float x0Fraction = x0 - x0Floor;
+                const float x1Fraction = x1 - x1Ceil + 1.0f;
+
+                const float firstArea = 0.5f * scale
+                    * (1.0f - x0Fraction) * (1.0f - x0Fraction);
+
+                const float lastArea = 0.5f * scale * x1Fraction * x1Fraction;
+
+                row[x0Index] += area * firstArea;
+
+                if (x1Index == x0Index + 2)
+                {
+                    row[x0Index + 1] += area * (1.0f - firstArea - lastArea);
+                }
+                else
+                {
+                    const float secondArea = scale * (1.5f - x0Fraction);
+                    row[x0Index + 1] += area * (secondArea - firstArea);
+
+                    for (int i = x0Index + 2; i < x1Index - 1; ++i)
+                        row[i] += area * scale;
+
+                    const float remainingArea = secondArea
+                        + (float)(x1Index - x0Index - 3) * scale;
+
+                    row[x1Index - 1] += area
+                        * (1.0f - remainingArea - lastArea);
+                }
+
+                row[x1Index] += area * lastArea;
+            }
+
+            x = xNext;
+        }
+    }
+
+    /** ==================================================================== **/
+
+    /** Fills the path into a SingleChannel Image the same size as the
+        rasteriser, replacing whatever was in it before.
+    **/
+    void renderInto(
+        Image &image,
+        const Path &path,
+        const AffineTransform &transform = {})
+    {
+        jassert(image.getFormat() == Image::PixelFormat::SingleChannel);
+        jassert(image.getWidth() == width && image.getHeight() == height);
+
+        zeromem(cells, sizeof(float) * (size_t)((width + 2) * height));
+
+        /** PathFlatteningIterator breaks the curves in the Path into straight
+            lines, and closes any sub-paths that were left open.
+
+            https://docs.juce.com/master/classPathFlatteningIterator.html
+        **/
+        PathFlatteningIterator iterator(path, transform);
+
+        while (iterator.next())
+        {
+            addLine(
+                Point<float>(iterator.x1, iterator.y1),
+                Point<float>(iterator.x2, iterator.y2)
+            );
+        }
+
+        /** This running sum is the only part that touches every pixel, and
+            each row can be summed independently of the others.
+        **/
+        Image::BitmapData data(image, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < height; ++y)
+        {
+            const float * const row = cells + y * (width + 2);
+            uint8 * const line = data.getLinePointer(y);
+
+            float coverage = 0.0f;
+
+            for (int x = 0; x < width; ++x)
+            {
+                coverage += row[x];
+
+                line[x * data.pixelStride] = (uint8)roundToInt(
+                    jmin(1.0f, std::abs(coverage)) * 255.0f
+                );
+            }
+        }
+    }
+};
+
+/** ======================================================================== **/
+
+struct Demo : public Component
+{
+    static constexpr int NumIterations = 100;
+    static constexpr int ZoomSize      = 32;
+
+    enum Shape
+    {
+        star,
+        curve,
+        ellipse,
+        numShapes
+    };
+
+    Path shapes[numShapes];
+
+    Image edgeTableImages[numShapes];
+    Image coverageImages[numShapes];
+
+    double edgeTableTimes[numShapes] = {};
+    double coverageTimes[numShapes]  = {};
+    double differences[numShapes]    = {};
+
+    CoverageRasteriser rasteriser;
+    bool useCoverageRasteriser = true;
+
+    Demo()
+    {
+        setSize(500, 500);
+    }
+
+    static String getShapeName(const int shape)
+    {
+        switch (shape)
+        {
+            case star:    return "Star";
+            case curve:   return "Curve";
+            case ellipse: return "Ellipse";
+            default:      return {};
+        }
+    }
+
+    /** ==================================================================== **/
+
+    /** The shapes are the star, curve and ellipse from the Simple Shapes and
+        Complex Paths demos, scaled to fit one column each.
+    **/
+    void createShapes(const float size)
+    {
+        for (Path &shape : shapes)
+            shape.clear();
+
+        shapes[star].addStar(
+            Point<float>(size * 0.5f, size * 0.5f),
+            5,
+            size * 0.15f,
+            size * 0.45f
+        );
+
+        shapes[curve].startNewSubPath(size * 0.4f, size * 0.05f);
+        shapes[curve].quadraticTo(
+            Point<float>(size * 0.95f, size * 0.5f),
+            Point<float>(size * 0.4f, size * 0.95f)
+        );
+        shapes[curve].closeSubPath();
+
+        shapes[ellipse].addEllipse(
+            Rectangle<float>(size, size).reduced(size * 0.05f)
+        );
+    }
+
+    /** Renders each shape with both rasterisers, timing them over a number of
+        iterations and measuring how different their results are.
+    **/
+    void runBenchmark(const int size)
+    {
+        rasteriser.setSize(size, size);
+
+        for (int i = 0; i < numShapes; ++i)
+        {
+            edgeTableImages[i] = Image(Image::SingleChannel, size, size, true);
+            coverageImages[i]  = Image(Image::SingleChannel, size, size, true);
+
+            /** The context is created once, so that we time clearing and
+                filling the shape rather than setting up a new context.
+            **/
+            Graphics g(edgeTableImages[i]);
+
+            double startTime = Time::getMillisecondCounterHiRes();
+
+            for (int n = 0; n < NumIterations; ++n)
+            {
+                edgeTableImages[i].clear(edgeTableImages[i].getBounds());
+                g.fillPath(shapes[i]);
+            }
+
+            edgeTableTimes[i] = (Time::getMillisecondCounterHiRes() - startTime)
+                / NumIterations;
+
+            startTime = Time::getMillisecondCounterHiRes();
+
+            for (int n = 0; n < NumIterations; ++n)
+                rasteriser.renderInto(coverageImages[i], shapes[i]);
+
+            coverageTimes[i] = (Time::getMillisecondCounterHiRes() - startTime)
+                / NumIterations;
+
+            differences[i] = getAverageDifference(
+                edgeTableImages[i],
+                coverageImages[i]
+            );
+        }
+    }
+
+    /** Returns the average difference in coverage across the pixels that
+        either rasteriser touched, as a percentage.
+    **/
+    static double getAverageDifference(const Image &a, const Image &b)
+    {
+        const Image::BitmapData dataA(a, Image::BitmapData::readOnly);
+        const Image::BitmapData dataB(b, Image::BitmapData::readOnly);
+
+        int64 total = 0;
+        int numPixels = 0;
+
+        for (int y = 0; y < a.getHeight(); ++y)
+        {
+            for (int x = 0; x < a.getWidth(); ++x)
+            {
+                const int alphaA = *dataA.getPixelPointer(x, y);
+                const int alphaB = *dataB.getPixelPointer(x, y);
+
+                if (alphaA == 0 && alphaB == 0)
+                    continue;
+
+                total += std::abs(alphaA - alphaB);
+                ++numPixels;
+            }
+        }
+
+        return numPixels > 0 ? (100.0 * total) / (255.0 * numPixels) : 0.0;
+    }
+
+    /** ==================================================================== **/
+
+    void resized() override
+    {
+        const int size = getWidth() / numShapes;
+
+        if (size <= 0)
+            return;
+
+        createShapes((float)size);
+        runBenchmark(size);
+    }
+
+    /** Click to switch between the two rasterisers. **/
+    void mouseDown(const MouseEvent &e) override
+    {
+        useCoverageRasteriser = !useCoverageRasteriser;
+        repaint();
+    }
+
+    void paint(Graphics &g) override
+    {
+        g.fillAll(Colours::darkslategrey);
+
+        const int size = getWidth() / numShapes;
+
+        for (int i = 0; i < numShapes; ++i)
+        {
+            const Image &image = useCoverageRasteriser
+                ? coverageImages[i]
+                : edgeTableImages[i];
+
+            /** SingleChannel images are drawn as a mask when the last
+                argument is true, filled with the current colour.
+            **/
+            g.setColour(Colours::white);
+            g.drawImageAt(image, i * size, 0, true);
+
+            /** Blow up a small area on the left edge of the shape so the
+                anti-aliasing can be compared pixel by pixel.
+            **/
+            const Rectangle<float> shapeBounds = shapes[i].getBounds();
+
+            /** The shape's edge can be close to the edge of the Image, so the
+                area is kept inside the Image.
+            **/
+            const Rectangle<int> zoomArea = Rectangle<int>(ZoomSize, ZoomSize)
+                .withCentre(
+                    Point<float>(
+                        shapeBounds.getX(),
+                        shapeBounds.getCentreY()
+                    ).roundToInt()
+                )
+                .constrainedWithin(image.getBounds());
+
+            const Rectangle<int> zoomBounds(
+                i * size + (size - ZoomSize * 4) / 2,
+                size,
+                ZoomSize * 4,
+                ZoomSize * 4
+            );
+
+            g.setImageResamplingQuality(Graphics::lowResamplingQuality);
+            g.drawImage(
+                image,
+                zoomBounds.getX(),
+                zoomBounds.getY(),
+                zoomBounds.getWidth(),
+                zoomBounds.getHeight(),
+                zoomArea.getX(),
+                zoomArea.getY(),
+                zoomArea.getWidth(),
+                zoomArea.getHeight(),
+                true
+            );
+
+            g.setColour(Colours::black);
+            g.drawRect(zoomBounds);
+        }
+
+        /** ================================================================ **/
+
+        Rectangle<int> textArea = getLocalBounds()
+            .withTop(size + ZoomSize * 4)
+            .reduced(10);
+
+        g.setColour(Colours::white);
+        g.setFont(16.0f);
+        g.drawText(
+            useCoverageRasteriser
+                ? "Exact coverage (click to switch)"
+                : "Edge table (click to switch)",
+            textArea.removeFromTop(30),
+            Justification::centredLeft
+        );
+
+        g.setFont(14.0f);
+
+        for (int i = 0; i < numShapes; ++i)
+        {
+            g.drawText(
+                getShapeName(i)
+                    + " - edge table: " + String(edgeTableTimes[i], 3) + "ms"
+                    + ", coverage: " + String(coverageTimes[i], 3) + "ms"
+                    + ", difference: " + String(differences[i], 1) + "%",
+                textArea.removeFromTop(20),
+                Justification::centredLeft
+            );
+        }
+    }
+};
@@ -48,9 +48,72 @@
 
 struct Demo : public Component
 {
+    Path ellipse;
+
     Demo()
     {
         setSize(500, 500);
+
+        #if 0 // change to 1 to time nested clip regions
+          timeNestedClips(false);
+          timeNestedClips(true);
+        #endif
+    }
+
+    /** Nests 10 rectangular clips, each with a small hole cut out of it, and
+        fills whatever is left 10,000 times, optionally with an ellipse clip
+        at the innermost level, then logs how long it took. Even one Path clip
+        at the bottom of a stack of rectangles turns the whole clip into an
+        edge table.
+    **/
+    static void timeNestedClips(const bool pathClip)
+    {
+        Image image(Image::PixelFormat::RGB, 500, 500, true);
+        Graphics g(image);
+
+        Path innerEllipse;
+        innerEllipse.addEllipse(image.getBounds().reduced(150).toFloat());
+
+        const int numLevels     = 10;
+        const int numIterations = 10000;
+        const double startTime  = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numIterations; ++i)
+        {
+            Graphics::ScopedSaveState saveState(g);
+
+            for (int level = 0; level < numLevels; ++level)
+            {
+                const Rectangle<int> area(
+                    image.getBounds().reduced(level * 10)
+                );
+
+                g.reduceClipRegion(area);
+                g.excludeClipRegion(area.withSize(5, 5));
+            }
+
+            if (pathClip)
+                g.reduceClipRegion(innerEllipse);
+
+            g.fillAll(Colours::red);
+        }
+
+        Logger::writeToLog(
+            String(numIterations) + " fills through " + String(numLevels)
+                + " nested clips " + (pathClip ? "with" : "without")
+                + " a Path clip took "
+                + String(Time::getMillisecondCounterHiRes() - startTime, 2)
+                + "ms"
+        );
+    }
+
+    /** The ellipse only changes when our size does, so we build it here
+        instead of building a new Path every time we paint.
+    **/
+    void resized() override
+    {
+        ellipse.clear();
+        ellipse.addEllipse(getLocalBounds().reduced(50).toFloat());
     }
 
     /** ==================================================================== **/
@@ -62,15 +125,35 @@ struct Demo : public Component
         A more advanced clip region can use an image to create a masked region.
         The alpha channel of the image will be used so that only non-transparent
         pixels of the image will be used as the clip region(s).
+
+        Rectangular clips are by far the cheapest. As long as every clip you
+        apply is a rectangle, JUCE's software renderer stores the clip as a
+        list of rectangles and can fill each one directly. As soon as a Path
+        or Image is used, the whole clip is converted into an edge table which
+        is slower to create and to fill. Whenever you can, prefer rectangles!
     **/
     void paint(Graphics& g) override
     {
         #if 1 // change to 0 to use the ellipse as the clip region
           g.reduceClipRegion(getLocalBounds().reduced(50));
+
+          /** Excluding rectangles from a rectangular clip will still leave us
+              with a list of rectangles, so this stays on the fast path.
+
+              https://docs.juce.com/master/classRectangleList.html
+          **/
+          #if 0 // change to 1 to cut a row of holes out of the clip region
+            for (int i = 0; i < 5; ++i)
+                g.excludeClipRegion(Rectangle<int>(75 + i * 75, 225, 50, 50));
+          #endif
         #else
-          Path path;
-          path.addEllipse(getLocalBounds().reduced(50).toFloat());
-          g.reduceClipRegion(path);
+          /** Caching the Path saves building it, but the clip still has to be
+              converted into an edge table on every paint. If what you draw
+              inside a Path clip doesn't change, draw it into an Image once
+              and draw that instead - see the button backgrounds in the
+              LookAndFeel Customisation demo.
+          **/
+          g.reduceClipRegion(ellipse);
         #endif
 
         g.fillAll(Colours::red);
@@ -51,6 +51,43 @@ struct Demo : public Component
     Demo()
     {
         setSize(500, 500);
+
+        #if 0 // change to 1 to time saving and restoring the state
+          timeStateStack(false);
+          timeStateStack(true);
+        #endif
+    }
+
+    /** Each saveState() pushes a full copy of the context's state onto the
+        stack, so it isn't free. This times 1,000,000 save/restore pairs, with
+        or without a clip change in between, and logs the results.
+
+        Colours and fonts are cheap to set again, so you don't need to save the
+        state just to change them. Save state for clip regions, transforms, and
+        origins, which are much harder to undo by hand.
+    **/
+    static void timeStateStack(const bool changeClip)
+    {
+        Image image(Image::PixelFormat::ARGB, 500, 500, true);
+        Graphics g(image);
+
+        const int numIterations = 1000000;
+        const double startTime  = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numIterations; ++i)
+        {
+            Graphics::ScopedSaveState saveState(g);
+
+            if (changeClip)
+                g.reduceClipRegion(i % 250, i % 250, 250, 250);
+        }
+
+        Logger::writeToLog(
+            String(numIterations) + " save/restore pairs "
+                + (changeClip ? "with" : "without") + " clip changes took "
+                + String(Time::getMillisecondCounterHiRes() - startTime, 2)
+                + "ms"
+        );
     }
 
     /** ==================================================================== **/
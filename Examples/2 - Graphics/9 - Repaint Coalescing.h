@@ -0,0 +1,233 @@
+/*******************************************************************************
+ The block below describes the properties of this PIP. A PIP is a short snippet
+ of code that can be read by the Projucer and used to generate a JUCE project.
+
+ BEGIN_JUCE_PIP_METADATA
+
+  name:             Repaint Coalescing
+  vendor:           Antonio Lassandro
+  website:          https://www.github.com/lassandroan/juce-graphics-workshop
+  description:      Merging and rate-limiting frequent repaint requests
+
+  dependencies:     juce_core, juce_gui_basics
+  exporters:        linux_make, vs2013, vs2015, vs2017, vs2019, xcode_mac
+
+  moduleFlags:      JUCE_STRICT_REFCOUNTEDPOINTER=1
+
+  type:             Component
+  mainClass:        Demo
+
+ END_JUCE_PIP_METADATA
+
+*******************************************************************************/
+
+/*
+  Author: Antonio Lassandro
+  Copyright 2019 Harrison Consoles
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+/** JUCE already merges repaint() calls that happen between two paints, but
+    every call still has to work out which part of the window is dirty and
+    may wake up the OS to schedule a paint. Meters and other widgets that call
+    repaint() from a fast timer can easily do this hundreds of times a second.
+
+    A RepaintScheduler collects repaint requests for a top-level Component,
+    merges them into a small list of rectangles, and only passes them on to
+    JUCE once per display frame.
+**/
+struct RepaintScheduler : private Timer
+{
+    /** If more rectangles than this pile up we merge them all into one. **/
+    static constexpr int MaxRectangles = 8;
+
+    Component &target;
+    RectangleList<int> dirtyArea;
+
+    int numRequests       = 0;
+    int lastFrameRequests = 0;
+    int lastFrameRepaints = 0;
+
+    /** Most displays refresh at 60Hz, so there is no point painting faster
+        than that.
+    **/
+    RepaintScheduler(Component &c, const int framesPerSecond = 60)
+        : target(c)
+    {
+        startTimerHz(framesPerSecond);
+    }
+
+    /** Requests a repaint of the given area, relative to the target. **/
+    void requestRepaint(const Rectangle<int> &area)
+    {
+        ++numRequests;
+
+        dirtyArea.add(area);
+
+        if (dirtyArea.getNumRectangles() > MaxRectangles)
+        {
+            dirtyArea.consolidate();
+
+            if (dirtyArea.getNumRectangles() > MaxRectangles)
+                dirtyArea = dirtyArea.getBounds();
+        }
+    }
+
+    /** Returns how many repaint requests were merged away in the last frame.
+    **/
+    int getNumCoalesced() const
+    {
+        return lastFrameRequests - lastFrameRepaints;
+    }
+
+    void timerCallback() override
+    {
+        lastFrameRequests = numRequests;
+        lastFrameRepaints = dirtyArea.getNumRectangles();
+        numRequests = 0;
+
+        for (const Rectangle<int> &area : dirtyArea)
+            target.repaint(area);
+
+        dirtyArea.clear();
+    }
+};
+
+/** ======================================================================== **/
+
+struct Meter : public Component
+{
+    float level = 0.0f;
+
+    std::function<void(const Rectangle<int>&)> onRepaintNeeded;
+
+    /** Only the part of the bar between the old and new levels has changed,
+        so that's the only part we ask to be repainted.
+    **/
+    void setLevel(const float newLevel)
+    {
+        const int oldY = getLevelY(level);
+        const int newY = getLevelY(newLevel);
+
+        level = newLevel;
+
+        if (oldY == newY)
+            return;
+
+        const Rectangle<int> changed(
+            0, jmin(oldY, newY),
+            getWidth(), std::abs(oldY - newY)
+        );
+
+        #if 1 // change to 0 to call repaint() directly on every change
+          if (onRepaintNeeded != nullptr)
+              onRepaintNeeded(changed + getPosition());
+        #else
+          repaint(changed);
+        #endif
+    }
+
+    int getLevelY(const float value) const
+    {
+        return roundToInt((1.0f - value) * getHeight());
+    }
+
+    void paint(Graphics &g) override
+    {
+        g.fillAll(Colours::black);
+
+        g.setColour(Colours::palegreen);
+        g.fillRect(getLocalBounds().withTop(getLevelY(level)));
+    }
+};
+
+/** ======================================================================== **/
+
+struct Demo : public Component, public Timer
+{
+    OwnedArray<Meter> meters;
+    RepaintScheduler scheduler { *this };
+
+    Demo()
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            Meter * const meter = meters.add(new Meter());
+            meter->setOpaque(true);
+            meter->onRepaintNeeded = [this](const Rectangle<int> &area) -> void
+            {
+                scheduler.requestRepaint(area);
+            };
+            addAndMakeVisible(meter);
+        }
+
+        setSize(500, 500);
+
+        /** Our meters update as fast as the Timer will let them, which is
+            often around 1000 times a second.
+        **/
+        startTimer(1);
+    }
+
+    /** ==================================================================== **/
+
+    void timerCallback() override
+    {
+        Random &random = Random::getSystemRandom();
+
+        for (Meter * const meter : meters)
+        {
+            meter->setLevel(jlimit(
+                0.0f,
+                1.0f,
+                meter->level + (random.nextFloat() - 0.5f) * 0.05f
+            ));
+        }
+
+        scheduler.requestRepaint(getLocalBounds().removeFromBottom(50));
+    }
+
+    void resized() override
+    {
+        Rectangle<int> bounds = getLocalBounds().reduced(25);
+        bounds.removeFromBottom(50);
+
+        const int meterWidth = bounds.getWidth() / meters.size();
+
+        for (Meter * const meter : meters)
+            meter->setBounds(bounds.removeFromLeft(meterWidth).reduced(2, 0));
+    }
+
+    void paint(Graphics &g) override
+    {
+        g.fillAll(findColour(ResizableWindow::backgroundColourId));
+
+        g.setColour(Colours::white);
+        g.setFont(16.0f);
+        g.drawText(
+            String(scheduler.lastFrameRequests) + " repaint requests, "
+                + String(scheduler.getNumCoalesced()) + " coalesced",
+            getLocalBounds().removeFromBottom(50),
+            Justification::centred
+        );
+    }
+};
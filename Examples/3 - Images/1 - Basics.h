@@ -49,6 +49,8 @@
 struct Demo : public Component
 {
     Image selectedImage;
+
+    bool imageIsOpaque = false;
 
     Demo()
     {
@@ -74,8 +76,41 @@ struct Demo : public Component
                 https://docs.juce.com/master/classImageCache.html
             **/
             selectedImage = ImageCache::getFromFile(fileChooser.getResult());
+
+            #if 0 // change to 1 to time decoding every image in the same folder
+              benchmarkDecoding(fileChooser.getResult().getParentDirectory());
+            #endif
         }
 
+        /** ================================================================ **/
+
+        /** PNG files are usually loaded as ARGB Images since they can contain
+            transparent pixels. Drawing an ARGB Image means every pixel has to
+            be blended with whatever is behind it.
+
+            If none of the pixels are see-through, we can convert the Image to
+            RGB and drawing it becomes a simple copy. While the Image covers
+            our entire area we can also mark ourselves as opaque, so our parent
+            doesn't need to paint behind us - see resized().
+
+            On macOS, Images are CoreGraphics images which always store an
+            alpha channel, even when you ask for RGB. There the conversion would
+            just copy the pixels, so we skip it, but the Image is still opaque.
+
+            https://docs.juce.com/master/classImage.html
+        **/
+        #if 1 // change to 0 to draw the Image in the format it was loaded as
+          imageIsOpaque = selectedImage.isRGB()
+              || (selectedImage.isARGB() && isFullyOpaque(selectedImage));
+
+          if (imageIsOpaque && selectedImage.isARGB() && canStoreRGB())
+              selectedImage = selectedImage.convertedToFormat(Image::RGB);
+        #endif
+
+        #if 0 // change to 1 to time drawing the Image in different ways
+          benchmarkDrawing(selectedImage);
+        #endif
+
         /** An Image is said to be "valid" if it has a block of allocated data
             assocaited with it. If the Image isn't pointing to any data, the
             isValid() call will return false.
@@ -93,6 +128,171 @@ struct Demo : public Component
 
     /** ==================================================================== **/
 
+    /** Image::BitmapData gives us direct access to an Image's pixels. ARGB
+        pixels are stored as PixelARGB, so we can check each pixel's alpha
+        value and stop as soon as we find one that isn't fully opaque.
+
+        https://docs.juce.com/master/classImage_1_1BitmapData.html
+    **/
+    static bool isFullyOpaque(const Image &image)
+    {
+        const Image::BitmapData data(image, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < data.height; ++y)
+        {
+            const uint8 *pixel = data.getLinePointer(y);
+
+            for (int x = 0; x < data.width; ++x, pixel += data.pixelStride)
+            {
+                if (reinterpret_cast<const PixelARGB*>(pixel)->getAlpha() < 255)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    /** Returns true if the platform's Images really store RGB pixels without
+        an alpha channel. On macOS, asking for an RGB Image gives you an ARGB
+        one instead.
+    **/
+    static bool canStoreRGB()
+    {
+        return Image(Image::RGB, 1, 1, false).isRGB();
+    }
+
+    /** ==================================================================== **/
+
+    /** Times drawing the Image into an RGB buffer many times and logs how many
+        gigabytes of source pixels were drawn per second for a straight copy,
+        a blend, and a blend with reduced opacity.
+
+        The number of bytes is taken from the Image's actual pixel data, so an
+        "RGB" Image on macOS is counted as 4 bytes per pixel.
+    **/
+    static void benchmarkDrawing(const Image &image)
+    {
+        static constexpr int NumIterations = 100;
+
+        if (!image.isValid())
+            return;
+
+        const Image rgb  = image.convertedToFormat(Image::RGB);
+        const Image argb = image.convertedToFormat(Image::ARGB);
+
+        Image target(Image::RGB, image.getWidth(), image.getHeight(), true);
+
+        const auto timeDrawing = [&target](
+            const String &name,
+            const Image &source,
+            const float opacity) -> void
+        {
+            const Image::BitmapData data(source, Image::BitmapData::readOnly);
+            const double bytes = (double)data.pixelStride
+                * data.width * data.height * NumIterations;
+
+            Graphics g(target);
+            g.setOpacity(opacity);
+
+            const double startTime = Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < NumIterations; ++i)
+                g.drawImageAt(source, 0, 0);
+
+            const double seconds =
+                (Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+            Logger::writeToLog(
+                name + ": " + String(bytes / seconds / 1.0e9, 2) + " GB/s"
+            );
+        };
+
+        timeDrawing("Copy (RGB)", rgb, 1.0f);
+        timeDrawing("Blend (ARGB)", argb, 1.0f);
+        timeDrawing("Blend with opacity (ARGB)", argb, 0.5f);
+    }
+
+    /** ==================================================================== **/
+
+    /** Most of the time spent loading an Image goes into decoding it, not
+        reading the file. Here we read each file into memory first and then
+        time only ImageFileFormat::loadFrom(), which is what ImageCache uses
+        to decode the data. Going through ImageCache directly would just hand
+        us the Image it already decoded the first time.
+
+        The throughput is measured in decoded pixel data, so PNG and JPEG files
+        of different sizes can be compared with each other.
+
+        https://docs.juce.com/master/classImageFileFormat.html
+    **/
+    static void benchmarkDecoding(const File &folder)
+    {
+        static constexpr int NumIterations = 10;
+
+        const Array<File> files = folder.findChildFiles(
+            File::findFiles,
+            false,
+            "*.png;*.jpeg;*.jpg"
+        );
+
+        for (const File &file : files)
+        {
+            MemoryBlock fileData;
+
+            if (!file.loadFileAsData(fileData))
+                continue;
+
+            Image image;
+
+            const double startTime = Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < NumIterations; ++i)
+            {
+                image = ImageFileFormat::loadFrom(
+                    fileData.getData(),
+                    fileData.getSize()
+                );
+            }
+
+            const double endTime    = Time::getMillisecondCounterHiRes();
+            const double decodeTime = (endTime - startTime) / NumIterations;
+
+            if (!image.isValid())
+                continue;
+
+            /** JPEGs and PNGs without transparency decode to RGB, so we
+                count the bytes each decoded pixel really takes up.
+            **/
+            const Image::BitmapData data(image, Image::BitmapData::readOnly);
+
+            const double megabytes = (double)data.pixelStride
+                * data.width * data.height / (1024.0 * 1024.0);
+
+            Logger::writeToLog(
+                file.getFileName()
+                    + " (" + String(image.getWidth())
+                    + "x" + String(image.getHeight())
+                    + (image.isARGB() ? " ARGB" : " RGB") + "): "
+                    + String(decodeTime, 2) + "ms, "
+                    + String(megabytes / (decodeTime / 1000.0), 1) + "MB/s"
+            );
+        }
+    }
+
+    /** ==================================================================== **/
+
+    /** The window can be resized to be larger than the Image, which would
+        leave part of our area unpainted. An opaque Component promises to
+        paint every pixel, so we only make that promise while it's true.
+    **/
+    void resized() override
+    {
+        setOpaque(
+            imageIsOpaque
+            && selectedImage.getBounds().contains(getLocalBounds())
+        );
+    }
+
     void paint(Graphics &g) override
     {
         /** You can only draw an image if it is valid! Otherwise the graphics
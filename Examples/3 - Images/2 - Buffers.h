@@ -46,29 +46,277 @@
 
 #pragma once
 
+/** Creating an Image allocates a block of memory for its pixels, and deleting
+    the Image frees that memory again. When buffers are created and thrown away
+    every time something is painted, that is a lot of work for the allocator.
+
+    An ImagePool keeps hold of every Image it hands out. Once nobody else is
+    using one of them, its pixel data can be handed out again to the next
+    request with the same format and a similar size.
+**/
+struct ImagePool
+{
+    /** Sizes are rounded up to a multiple of this, so that buffers which are
+        only a few pixels different in size can share the same pixel data.
+    **/
+    static constexpr int SizeGranularity = 64;
+
+    int64 maxRetainedBytes = 32 * 1024 * 1024;
+
+    Array<Image> images;
+
+    int numRequests = 0;
+    int numReused   = 0;
+
+    static int roundUp(const int size)
+    {
+        return (size + SizeGranularity - 1) / SizeGranularity * SizeGranularity;
+    }
+
+    /** RGB Images don't always use 3 bytes per pixel, and rows may be padded,
+        so we ask the Image how its pixel data is laid out.
+    **/
+    static int64 getBytes(const Image &image)
+    {
+        const Image::BitmapData data(image, Image::BitmapData::readOnly);
+        return (int64)data.lineStride * data.height;
+    }
+
+    /** Returns an Image with the given format and size.
+
+        The Image that is returned shares its pixel data with one of the Images
+        in the pool. When the pool's Image is the only one left referring to
+        that pixel data, we know it is free to be used again.
+
+        If clearImage is false and the pixel data gets re-used, it will still
+        hold whatever was drawn into it last time.
+    **/
+    Image getImage(
+        const Image::PixelFormat format,
+        const int width,
+        const int height,
+        const bool clearImage)
+    {
+        ++numRequests;
+
+        const int pooledWidth  = roundUp(width);
+        const int pooledHeight = roundUp(height);
+
+        Image pooled;
+
+        for (const Image &image : images)
+        {
+            if (image.getReferenceCount() == 1
+                && image.getFormat() == format
+                && image.getWidth()  == pooledWidth
+                && image.getHeight() == pooledHeight)
+            {
+                pooled = image;
+                break;
+            }
+        }
+
+        if (pooled.isValid())
+        {
+            ++numReused;
+
+            if (clearImage)
+                pooled.clear({0, 0, width, height});
+        }
+        else
+        {
+            pooled = Image(format, pooledWidth, pooledHeight, clearImage);
+            images.add(pooled);
+
+            releaseUnusedImages();
+        }
+
+        return pooled.getClippedImage({0, 0, width, height});
+    }
+
+    /** Drops unused Images from the pool, oldest first, until it holds no more
+        than maxRetainedBytes.
+    **/
+    void releaseUnusedImages()
+    {
+        int64 totalBytes = 0;
+
+        for (const Image &image : images)
+            totalBytes += getBytes(image);
+
+        for (int i = 0; i < images.size() && totalBytes > maxRetainedBytes;)
+        {
+            if (images.getReference(i).getReferenceCount() == 1)
+            {
+                totalBytes -= getBytes(images.getReference(i));
+                images.remove(i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    float getReuseRate() const
+    {
+        return numRequests > 0 ? (float)numReused / numRequests : 0.0f;
+    }
+};
+
+/** ======================================================================== **/
+
 struct Demo : public Component
 {
+    ImagePool imagePool;
     Image buffer;
 
+    Graphics::ResamplingQuality quality = Graphics::lowResamplingQuality;
+    double drawTime = 0.0;
+
     Demo()
     {
         setSize(500, 500);
 
+        #if 0 // change to 1 to time drawing a large Image with transforms
+          timeTransformedDrawing();
+        #endif
+    }
+
+    /** Draws a 1024x1024 Image offscreen with a rotation, a scale and a
+        shear, at each resampling quality, and logs the average time each
+        combination took.
+    **/
+    static void timeTransformedDrawing()
+    {
+        static constexpr int Size          = 1024;
+        static constexpr int NumIterations = 20;
+
+        Image source(Image::PixelFormat::RGB, Size, Size, false);
+
+        {
+            Graphics g(source);
+            g.fillCheckerBoard(
+                source.getBounds().toFloat(),
+                16.0f,
+                16.0f,
+                Colours::deepskyblue,
+                Colours::white
+            );
+        }
+
+        Image target(Image::PixelFormat::RGB, Size, Size, true);
+        Graphics g(target);
+
+        const float centre = Size / 2.0f;
+
+        const std::pair<String, AffineTransform> transforms[] = {
+            {
+                "Rotated",
+                AffineTransform::rotation(M_PI / 7.0f, centre, centre)
+            },
+            {
+                "Scaled",
+                AffineTransform::scale(0.75f, 1.25f, centre, centre)
+            },
+            {
+                "Sheared",
+                AffineTransform::shear(0.2f, 0.0f)
+            }
+        };
+
+        const std::pair<String, Graphics::ResamplingQuality> qualities[] = {
+            { "low",    Graphics::lowResamplingQuality },
+            { "medium", Graphics::mediumResamplingQuality },
+            { "high",   Graphics::highResamplingQuality }
+        };
+
+        for (const auto &transform : transforms)
+        {
+            for (const auto &quality : qualities)
+            {
+                g.setImageResamplingQuality(quality.second);
+
+                const double startTime = Time::getMillisecondCounterHiRes();
+
+                for (int i = 0; i < NumIterations; ++i)
+                    g.drawImageTransformed(source, transform.second);
+
+                const double drawTime =
+                    (Time::getMillisecondCounterHiRes() - startTime)
+                        / NumIterations;
+
+                Logger::writeToLog(
+                    transform.first + ", " + quality.first + " quality: "
+                        + String(drawTime, 2) + "ms"
+                );
+            }
+        }
+    }
+
+    /** ==================================================================== **/
+
+    /** Our buffer is re-drawn whenever the window changes size. **/
+    void resized() override
+    {
+        /** An Image can't be zero pixels wide or high, so there's nothing to
+            draw until we have a size.
+        **/
+        if (getLocalBounds().isEmpty())
+        {
+            buffer = Image();
+            return;
+        }
+
+        /** Our buffer gets completely filled with an opaque colour, so it never
+            needs an alpha channel. Drawing an RGB Image is a straight copy
+            since there is nothing to blend with what's behind it.
+
+            An RGB Image only stores 3 bytes for each pixel instead of 4 when it
+            uses JUCE's software renderer, which is the default on Windows and
+            Linux. On macOS, Images are CoreGraphics images by default, and they
+            use 4 bytes per pixel even when you ask for RGB. You can pass a
+            SoftwareImageType to the Image constructor if the memory matters
+            more than how fast the Image is drawn.
+
+            SingleChannel Images only store 1 byte for each pixel. They are
+            useful as masks, e.g. for caching the shape of text or a Path.
+
+            https://docs.juce.com/master/classImage.html
+        **/
+        #if 1 // change to 0 to give the buffer an alpha channel
+          const Image::PixelFormat format = Image::PixelFormat::RGB;
+        #else
+          const Image::PixelFormat format = Image::PixelFormat::ARGB;
+        #endif
+
         /** ================================================================ **/
 
         /** We can create a new Image here, which will allocate the Image's
             pixel data based on the format and size that we provide.
         **/
-        buffer = Image(
-            /** The image will have red, green, blue, and alpha channels. **/
-            Image::PixelFormat::ARGB,
-            /** The image will match the size of our component. **/
-            500, 500,
-            /** We leave the image data uninitialised since we will be drawing
-                into it and filling the entire area.
-            **/
-            false
-        );
+        #if 1 // change to 0 to re-use pixel data from previous buffers
+          buffer = Image(
+              /** The image will use the format that we picked above. **/
+              format,
+              /** The image will match the size of our component. **/
+              getWidth(), getHeight(),
+              /** We leave the image data uninitialised since we will be
+                  drawing into it and filling the entire area.
+              **/
+              false
+          );
+        #else
+          /** We release the old buffer first so its pixel data can be re-used
+              for the new one.
+          **/
+          buffer = Image();
+          buffer = imagePool.getImage(
+              format,
+              getWidth(), getHeight(),
+              false
+          );
+        #endif
 
         /** ================================================================ **/
 
@@ -88,8 +336,91 @@ struct Demo : public Component
 
     void paint(Graphics& g) override
     {
-        if (buffer.isValid())
-            g.drawImageAt(buffer, 0, 0);
+        if (!buffer.isValid())
+            return;
+
+        #if 1 // change to 0 to draw the buffer rotated, scaled, and sheared
+          g.drawImageAt(buffer, 0, 0);
+        #else
+          /** When an Image is drawn with a transform that isn't a simple
+              translation, each pixel on screen has to be resampled from the
+              source Image. The resampling quality decides how this is done:
+
+                - lowResamplingQuality uses the nearest source pixel
+                - mediumResamplingQuality blends the four nearest pixels
+                - highResamplingQuality is treated the same as medium by
+                  JUCE's software renderer, but may be better on others
+
+              Nearest-neighbour is much cheaper but looks jagged, especially
+              along the rotated edges of the Image.
+
+              https://docs.juce.com/master/classGraphics.html
+          **/
+          g.fillAll(Colours::black);
+          g.setImageResamplingQuality(quality);
+
+          const double startTime = Time::getMillisecondCounterHiRes();
+
+          g.drawImageTransformed(
+              buffer,
+              AffineTransform()
+                  .rotated(M_PI / 7.0f, 250.0f, 250.0f)
+                  .scaled(0.75f, 0.75f, 250.0f, 250.0f)
+                  .sheared(0.2f, 0.0f)
+          );
+
+          drawTime = Time::getMillisecondCounterHiRes() - startTime;
+
+          g.setColour(Colours::white);
+          g.setFont(16.0f);
+          g.drawText(
+              "Quality " + String((int)quality) + ": "
+                  + String(drawTime, 2) + "ms (click to change)",
+              getLocalBounds().reduced(10),
+              Justification::bottomLeft
+          );
+        #endif
+
+        /** Resize the window a few times to see how often the pool is able to
+            re-use pixel data.
+        **/
+        if (imagePool.numRequests > 0)
+        {
+            g.setColour(Colours::white);
+            g.setFont(16.0f);
+            g.drawText(
+                "Image pool: " + String(imagePool.numReused) + " of "
+                    + String(imagePool.numRequests) + " buffers re-used ("
+                    + String(imagePool.getReuseRate() * 100.0f, 1) + "%)",
+                getLocalBounds().reduced(10),
+                Justification::topLeft
+            );
+        }
+    }
+
+    /** Clicking cycles through the resampling qualities. This only makes a
+        difference when the buffer is drawn transformed in paint().
+    **/
+    #if 0 // change to 1 as well when drawing the buffer transformed
+    void mouseDown(const MouseEvent &e) override
+    {
+        switch (quality)
+        {
+            case Graphics::lowResamplingQuality:
+                quality = Graphics::mediumResamplingQuality;
+                break;
+
+            case Graphics::mediumResamplingQuality:
+                quality = Graphics::highResamplingQuality;
+                break;
+
+            default:
+                quality = Graphics::lowResamplingQuality;
+                break;
+        }
+
+        repaint();
     }
+    #endif
 };
 
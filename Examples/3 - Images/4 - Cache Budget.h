@@ -0,0 +1,617 @@
+/*******************************************************************************
+ The block below describes the properties of this PIP. A PIP is a short snippet
+ of code that can be read by the Projucer and used to generate a JUCE project.
+
+ BEGIN_JUCE_PIP_METADATA
+
+  name:             Cache Budget
+  vendor:           Antonio Lassandro
+  website:          https://www.github.com/lassandroan/juce-graphics-workshop
+  description:      Sharing a memory budget between component image caches
+
+  dependencies:     juce_core, juce_gui_basics
+  exporters:        linux_make, vs2013, vs2015, vs2017, vs2019, xcode_mac
+
+  moduleFlags:      JUCE_STRICT_REFCOUNTEDPOINTER=1
+
+  type:             Component
+  mainClass:        Demo
+
+ END_JUCE_PIP_METADATA
+
+*******************************************************************************/
+
+/*
+  Author: Antonio Lassandro
+  Copyright 2019 Harrison Consoles
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+struct BudgetedImageCache;
+
+/** setBufferedToImage() gives each Component its own cached Image with no
+    limit on how much memory all of those Images can take up.
+
+    A CacheBudget keeps track of every BudgetedImageCache that uses it, in
+    order from least to most recently painted. Before a cache creates a new
+    Image, the budget makes room for it by releasing other caches: first the
+    ones whose Components can't be seen, then the least recently painted.
+
+    Caches that were painted in the current frame are never released, since
+    they would only have to be rendered again before the frame is over. If
+    there still isn't enough room, the new cache doesn't get an Image and its
+    Component is painted directly instead.
+**/
+struct CacheBudget
+{
+    int64 maxBytes = 1024 * 1024;
+    uint32 currentFrame = 0;
+
+    Array<BudgetedImageCache*> caches;
+
+    /** Call this at the start of each paint() of the Component that holds
+        the cached Components, before any of them get painted.
+    **/
+    void beginFrame()
+    {
+        ++currentFrame;
+    }
+
+    bool makeRoomFor(BudgetedImageCache &cache, int64 bytes);
+
+    void cacheUsed(BudgetedImageCache &cache);
+    void cacheRemoved(BudgetedImageCache &cache);
+
+    int64 getTotalBytes() const;
+    StringArray getReport() const;
+};
+
+/** ======================================================================== **/
+
+/** A CachedComponentImage is what setBufferedToImage() uses under the hood.
+    By writing our own we can decide how and when the cached Image is created,
+    and keep statistics on how well it is working.
+
+    Caching only pays off when a Component is expensive to paint _and_ gets
+    painted more often than it changes. We keep a running count of both, and
+    when the Component is cheap to paint or changes nearly every time it is
+    painted we skip the cache and paint it directly instead.
+
+    https://docs.juce.com/master/classCachedComponentImage.html
+**/
+struct BudgetedImageCache : public CachedComponentImage
+{
+    static constexpr double MinPaintTime = 0.05; // milliseconds
+    static constexpr int    WindowSize   = 32;
+
+    Component &owner;
+    CacheBudget &budget;
+
+    Image image;
+
+    /** Only the parts of the Image that have been invalidated since it was
+        last painted need to be re-rendered, so we keep track of which parts
+        are still valid.
+    **/
+    RectangleList<int> validArea;
+
+    int hits   = 0;
+    int misses = 0;
+    int partialRenders = 0;
+    int bypassed = 0;
+
+    int recentPaints = 0;
+    int recentInvalidations = 0;
+
+    /** Full paints and partial re-renders are averaged separately, so we can
+        see how much re-rendering only the invalid area saves.
+    **/
+    double averagePaintTime   = 0.0;
+    double averagePartialTime = 0.0;
+
+    uint32 lastFrame = 0;
+
+    BudgetedImageCache(Component &c, CacheBudget &b)
+        : owner(c), budget(b)
+    {
+    }
+
+    ~BudgetedImageCache()
+    {
+        budget.cacheRemoved(*this);
+    }
+
+    /** ==================================================================== **/
+
+    /** How many bytes a pixel takes up depends on the platform as well as
+        the format - RGB images are stored with 4 bytes per pixel on some
+        platforms - so we ask a tiny Image of the same format rather than
+        guessing. This is only an estimate, since rows may also be padded.
+    **/
+    static int64 getBytes(
+        const Image::PixelFormat format,
+        const int width,
+        const int height)
+    {
+        const Image pixel(format, 1, 1, false);
+        const Image::BitmapData data(pixel, Image::BitmapData::readOnly);
+
+        return (int64)width * height * data.pixelStride;
+    }
+
+    int64 getBytes() const
+    {
+        if (!image.isValid())
+            return 0;
+
+        const Image::BitmapData data(image, Image::BitmapData::readOnly);
+
+        return (int64)data.lineStride * data.height;
+    }
+
+    /** A Component that is hidden, or has been moved outside of its parent,
+        won't be painted until that changes.
+    **/
+    bool isOwnerOnScreen() const
+    {
+        if (!owner.isShowing())
+            return false;
+
+        const Component * const parent = owner.getParentComponent();
+
+        return parent == nullptr
+            || parent->getLocalBounds().intersects(owner.getBoundsInParent());
+    }
+
+    bool isWorthCaching() const
+    {
+        /** Give the Component a few paints before deciding anything. **/
+        if (recentPaints < WindowSize / 4)
+            return true;
+
+        return averagePaintTime >= MinPaintTime
+            && recentInvalidations * 2 < recentPaints;
+    }
+
+    /** Paints the owner into the given context and returns how long it took.
+
+        When painting into our Image the owner's alpha is ignored, because it
+        gets applied when the Image is drawn. When we skip the cache it has to
+        be applied while painting.
+    **/
+    double paintOwner(Graphics &g, const bool ignoreAlphaLevel)
+    {
+        const double startTime = Time::getMillisecondCounterHiRes();
+
+        owner.paintEntireComponent(g, ignoreAlphaLevel);
+
+        return Time::getMillisecondCounterHiRes() - startTime;
+    }
+
+    static void addToAverage(double &average, const double time)
+    {
+        average += (time - average) * 0.25;
+    }
+
+    /** ==================================================================== **/
+
+    void paint(Graphics &g) override
+    {
+        /** Halve the counters every so often so they only reflect how the
+            Component has been used recently.
+        **/
+        if (++recentPaints > WindowSize)
+        {
+            recentPaints /= 2;
+            recentInvalidations /= 2;
+        }
+
+        lastFrame = budget.currentFrame;
+
+        if (!isWorthCaching())
+        {
+            ++bypassed;
+            releaseResources();
+            addToAverage(averagePaintTime, paintOwner(g, false));
+            return;
+        }
+
+        const Rectangle<int> bounds = owner.getLocalBounds();
+
+        if (image.isNull() || image.getBounds() != bounds)
+        {
+            const Image::PixelFormat format = owner.isOpaque()
+                ? Image::PixelFormat::RGB
+                : Image::PixelFormat::ARGB;
+
+            const int width  = jmax(1, bounds.getWidth());
+            const int height = jmax(1, bounds.getHeight());
+
+            if (!budget.makeRoomFor(*this, getBytes(format, width, height)))
+            {
+                ++bypassed;
+                releaseResources();
+                addToAverage(averagePaintTime, paintOwner(g, false));
+                return;
+            }
+
+            image = Image(format, width, height, !owner.isOpaque());
+            validArea.clear();
+        }
+
+        if (validArea.containsRectangle(bounds))
+        {
+            ++hits;
+        }
+        else
+        {
+            const bool isPartial = !validArea.isEmpty();
+
+            if (isPartial)
+                ++partialRenders;
+            else
+                ++misses;
+
+            RectangleList<int> invalidArea(bounds);
+            invalidArea.subtract(validArea);
+
+            /** Clipping to the invalid area means the owner's paint() only
+                touches the pixels that actually changed, and everything else
+                in the Image is left as it was.
+            **/
+            Graphics imageGraphics(image);
+            imageGraphics.reduceClipRegion(invalidArea);
+
+            if (!owner.isOpaque())
+            {
+                for (const Rectangle<int> &area : invalidArea)
+                    image.clear(area);
+            }
+
+            const double paintTime = paintOwner(imageGraphics, true);
+
+            addToAverage(
+                isPartial ? averagePartialTime : averagePaintTime,
+                paintTime
+            );
+
+            validArea = bounds;
+        }
+
+        g.setColour(Colours::black.withAlpha(owner.getAlpha()));
+        g.drawImageAt(image, 0, 0);
+
+        budget.cacheUsed(*this);
+    }
+
+    bool invalidateAll() override
+    {
+        ++recentInvalidations;
+        validArea.clear();
+        return true;
+    }
+
+    /** Small changes are cheap to re-render from the cache, so only the ones
+        that cover at least half of the Component count as a change.
+    **/
+    bool invalidate(const Rectangle<int> &area) override
+    {
+        const Rectangle<int> changed = area.getIntersection(
+            owner.getLocalBounds()
+        );
+
+        if ((int64)changed.getWidth() * changed.getHeight() * 2
+            >= (int64)owner.getWidth() * owner.getHeight())
+            ++recentInvalidations;
+
+        validArea.subtract(area);
+        return true;
+    }
+
+    void releaseResources() override
+    {
+        image = Image();
+        validArea.clear();
+    }
+};
+
+/** ======================================================================== **/
+
+bool CacheBudget::makeRoomFor(BudgetedImageCache &cache, const int64 bytes)
+{
+    int64 totalBytes = getTotalBytes() - cache.getBytes() + bytes;
+
+    /** The first pass only releases caches whose Components can't be seen,
+        the second releases the rest from least to most recently used.
+    **/
+    for (int pass = 0; pass < 2 && totalBytes > maxBytes; ++pass)
+    {
+        for (BudgetedImageCache * const other : caches)
+        {
+            if (totalBytes <= maxBytes)
+                break;
+
+            if (other == &cache
+                || other->lastFrame == currentFrame
+                || !other->image.isValid())
+                continue;
+
+            if (pass == 0 && other->isOwnerOnScreen())
+                continue;
+
+            totalBytes -= other->getBytes();
+            other->releaseResources();
+        }
+    }
+
+    return totalBytes <= maxBytes;
+}
+
+void CacheBudget::cacheUsed(BudgetedImageCache &cache)
+{
+    /** Move the cache to the end of the list, since it is now the most
+        recently used one.
+    **/
+    caches.removeFirstMatchingValue(&cache);
+    caches.add(&cache);
+}
+
+void CacheBudget::cacheRemoved(BudgetedImageCache &cache)
+{
+    caches.removeFirstMatchingValue(&cache);
+}
+
+int64 CacheBudget::getTotalBytes() const
+{
+    int64 totalBytes = 0;
+
+    for (BudgetedImageCache * const cache : caches)
+        totalBytes += cache->getBytes();
+
+    return totalBytes;
+}
+
+StringArray CacheBudget::getReport() const
+{
+    StringArray report;
+
+    for (BudgetedImageCache * const cache : caches)
+    {
+        report.add(
+            cache->owner.getName()
+                + ": " + String(cache->hits) + " hits, "
+                + String(cache->misses) + " misses, "
+                + String(cache->partialRenders) + " partial, "
+                + String(cache->bypassed) + " bypassed, "
+                + String(cache->averagePaintTime, 2) + "ms full, "
+                + String(cache->averagePartialTime, 2) + "ms partial, "
+                + String(cache->getBytes() / 1024) + "KB"
+        );
+    }
+
+    return report;
+}
+
+/** ======================================================================== **/
+
+struct Square : public Component
+{
+    /** Only the area around the click is repainted, so only that part of the
+        cached Image gets re-rendered.
+    **/
+    void mouseDown(const MouseEvent &e) override
+    {
+        repaint(Rectangle<int>(10, 10).withCentre(e.getPosition()));
+    }
+
+    /** We draw lots of small circles here to make the Square expensive enough
+        to paint that caching is worth it.
+    **/
+    void paint(Graphics &g) override
+    {
+        Random &random = Random::getSystemRandom();
+
+        g.fillAll(Colours::black);
+
+        for (int i = 0; i < 500; ++i)
+        {
+            g.setColour(Colour((uint32)random.nextInt()).withAlpha(0.5f));
+            g.fillEllipse(
+                random.nextFloat() * getWidth(),
+                random.nextFloat() * getHeight(),
+                10.0f,
+                10.0f
+            );
+        }
+    }
+};
+
+struct Demo : public Component, public Timer
+{
+    /** The budget must outlive the Squares, since each Square's cache removes
+        itself from the budget when it is deleted.
+    **/
+    CacheBudget budget;
+
+    OwnedArray<Square> squares;
+
+    int numTicks = 0;
+
+    Demo()
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            Square * const square = squares.add(new Square());
+            square->setName("Square " + String(i + 1));
+            square->setOpaque(true);
+            addAndMakeVisible(square);
+
+            /** The Component takes ownership of the CachedComponentImage. **/
+            square->setCachedComponentImage(
+                new BudgetedImageCache(*square, budget)
+            );
+        }
+
+        /** Each Square takes about 10.5KB, so 12 of them fit in the budget
+            at once - just enough for the Squares that are showing.
+        **/
+        budget.maxBytes = 128 * 1024;
+
+        hideRow(0);
+        setSize(500, 500);
+
+        #if 0 // change to 1 to time a small repaint of a very large cache
+          timePartialRender();
+        #endif
+
+        /** Repainting the whole Demo every second means every Square that is
+            showing gets painted, even when it hasn't changed.
+        **/
+        startTimer(1000);
+    }
+
+    /** Repaints random 10x10 areas of a 2000x2000 cached Square, re-rendering
+        just that area of the cache and then the whole cache each time, and
+        logs the average time of each.
+    **/
+    static void timePartialRender()
+    {
+        static constexpr int Size          = 2000;
+        static constexpr int NumIterations = 100;
+
+        CacheBudget largeBudget;
+        largeBudget.maxBytes = (int64)Size * Size * 4;
+
+        Square square;
+        square.setOpaque(true);
+        square.setBounds(0, 0, Size, Size);
+
+        BudgetedImageCache cache(square, largeBudget);
+
+        Image target(Image::PixelFormat::RGB, Size, Size, false);
+        Graphics g(target);
+
+        /** The first paint renders the whole cache. **/
+        cache.paint(g);
+
+        Random random;
+        double partialTime = 0.0;
+        double fullTime    = 0.0;
+
+        for (int i = 0; i < NumIterations; ++i)
+        {
+            const Rectangle<int> area(
+                random.nextInt(Size - 10),
+                random.nextInt(Size - 10),
+                10,
+                10
+            );
+
+            /** Like a real repaint, only the changed area gets drawn. **/
+            Graphics::ScopedSaveState saveState(g);
+            g.reduceClipRegion(area);
+
+            cache.invalidate(area);
+
+            double startTime = Time::getMillisecondCounterHiRes();
+            cache.paint(g);
+            partialTime += Time::getMillisecondCounterHiRes() - startTime;
+
+            /** Clearing the valid area directly re-renders the whole cache,
+                without it being counted as a change to the Component.
+            **/
+            cache.validArea.clear();
+
+            startTime = Time::getMillisecondCounterHiRes();
+            cache.paint(g);
+            fullTime += Time::getMillisecondCounterHiRes() - startTime;
+        }
+
+        Logger::writeToLog(
+            "10x10 repaint of a 2000x2000 cache: "
+                + String(partialTime / NumIterations, 3) + "ms partial, "
+                + String(fullTime / NumIterations, 3) + "ms full"
+        );
+    }
+
+    /** ==================================================================== **/
+
+    void hideRow(const int row)
+    {
+        for (int i = 0; i < squares.size(); ++i)
+            squares[i]->setVisible(i / 4 != row);
+    }
+
+    /** Every few seconds a different row of Squares is hidden. The caches of
+        the hidden row are the first to go when the row that has just been
+        shown again needs room for its Images.
+    **/
+    void timerCallback() override
+    {
+        if (++numTicks % 5 == 0)
+            hideRow((numTicks / 5) % 4);
+
+        repaint();
+    }
+
+    void resized() override
+    {
+        const int size = 60;
+        const int step = size + 10;
+
+        for (int i = 0; i < squares.size(); ++i)
+        {
+            squares[i]->setBounds(
+                10 + (i % 4) * step,
+                10 + (i / 4) * step,
+                size,
+                size
+            );
+        }
+    }
+
+    void paint(Graphics &g) override
+    {
+        budget.beginFrame();
+
+        g.fillAll(findColour(ResizableWindow::backgroundColourId));
+
+        /** Click on some of the Squares to see how their statistics change.
+            The report lists the caches from least to most recently used.
+        **/
+        g.setColour(Colours::white);
+        g.setFont(12.0f);
+        g.drawText(
+            "Cached: " + String(budget.getTotalBytes() / 1024) + "KB of "
+                + String(budget.maxBytes / 1024) + "KB",
+            Rectangle<int>(300, 10, 190, 20),
+            Justification::centredLeft
+        );
+
+        g.drawFittedText(
+            budget.getReport().joinIntoString("\n"),
+            Rectangle<int>(10, 300, 480, 190),
+            Justification::topLeft,
+            16
+        );
+    }
+};
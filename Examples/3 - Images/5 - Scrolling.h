@@ -0,0 +1,237 @@
+/*******************************************************************************
+ The block below describes the properties of this PIP. A PIP is a short snippet
+ of code that can be read by the Projucer and used to generate a JUCE project.
+
+ BEGIN_JUCE_PIP_METADATA
+
+  name:             Scrolling
+  vendor:           Antonio Lassandro
+  website:          https://www.github.com/lassandroan/juce-graphics-workshop
+  description:      Scrolling a cached image by moving its existing pixels
+
+  dependencies:     juce_core, juce_gui_basics
+  exporters:        linux_make, vs2013, vs2015, vs2017, vs2019, xcode_mac
+
+  moduleFlags:      JUCE_STRICT_REFCOUNTEDPOINTER=1
+
+  type:             Component
+  mainClass:        Demo
+
+ END_JUCE_PIP_METADATA
+
+*******************************************************************************/
+
+/*
+  Author: Antonio Lassandro
+  Copyright 2019 Harrison Consoles
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+/** A very long list that keeps its contents in a cached Image.
+
+    When the list scrolls, most of what was on screen is still on screen, just
+    in a different place. Instead of repainting every row, we can move the
+    existing pixels inside the cached Image and only paint the strip of rows
+    that has just scrolled into view.
+**/
+struct List : public Component, public Timer
+{
+    static constexpr int NumRows   = 100000;
+    static constexpr int RowHeight = 20;
+
+    Image cache;
+    int scrollPosition = 0;
+    int scrollSpeed    = 3;
+
+    double frameTime = 0.0;
+
+    List()
+    {
+        setOpaque(true);
+        startTimerHz(60);
+    }
+
+    /** ==================================================================== **/
+
+    /** Paints the rows that overlap the given area of the list. **/
+    void paintRows(Graphics &g, const Rectangle<int> &area)
+    {
+        const int firstRow = (scrollPosition + area.getY()) / RowHeight;
+        const int lastRow  = (scrollPosition + area.getBottom()) / RowHeight;
+
+        g.setFont(14.0f);
+
+        for (int row = firstRow; row <= jmin(lastRow, NumRows - 1); ++row)
+        {
+            const Rectangle<int> rowBounds(
+                0,
+                row * RowHeight - scrollPosition,
+                getWidth(),
+                RowHeight
+            );
+
+            g.setColour(
+                (row % 2 == 0) ? Colours::darkslategrey : Colours::grey
+            );
+            g.fillRect(rowBounds);
+
+            g.setColour(Colours::white);
+            g.drawText(
+                "Row " + String(row + 1),
+                rowBounds.reduced(10, 0),
+                Justification::centredLeft
+            );
+        }
+    }
+
+    /** Paints the given area of the cached Image, leaving the rest of it as
+        it was.
+    **/
+    void renderIntoCache(const Rectangle<int> &area)
+    {
+        Graphics g(cache);
+        g.reduceClipRegion(area);
+        paintRows(g, area);
+    }
+
+    /** ==================================================================== **/
+
+    void scrollBy(const int distance)
+    {
+        const int maxPosition = jmax(0, NumRows * RowHeight - getHeight());
+        const int newPosition = jlimit(
+            0,
+            maxPosition,
+            scrollPosition + distance
+        );
+
+        const int delta = newPosition - scrollPosition;
+
+        if (delta == 0)
+            return;
+
+        scrollPosition = newPosition;
+
+        const double startTime = Time::getMillisecondCounterHiRes();
+
+        #if 1 // change to 0 to repaint every row each time the list scrolls
+          if (cache.isValid() && std::abs(delta) < getHeight())
+          {
+              const int width  = getWidth();
+              const int height = getHeight();
+
+              /** Image::moveImageSection() copies the pixels within the Image
+                  line by line, which is much cheaper than painting them again.
+
+                  https://docs.juce.com/master/classImage.html
+              **/
+              if (delta > 0)
+              {
+                  cache.moveImageSection(0, 0, 0, delta, width, height - delta);
+                  renderIntoCache({0, height - delta, width, delta});
+              }
+              else
+              {
+                  cache.moveImageSection(0, -delta, 0, 0, width, height + delta);
+                  renderIntoCache({0, 0, width, -delta});
+              }
+          }
+          else
+          {
+              renderIntoCache(getLocalBounds());
+          }
+        #else
+          renderIntoCache(getLocalBounds());
+        #endif
+
+        frameTime = Time::getMillisecondCounterHiRes() - startTime;
+
+        repaint();
+    }
+
+    void timerCallback() override
+    {
+        scrollBy(scrollSpeed);
+    }
+
+    /** Clicking pauses and resumes the scrolling. **/
+    void mouseDown(const MouseEvent &e) override
+    {
+        if (isTimerRunning())
+            stopTimer();
+        else
+            startTimerHz(60);
+    }
+
+    void mouseWheelMove(
+        const MouseEvent &e,
+        const MouseWheelDetails &wheel) override
+    {
+        scrollBy(roundToInt(wheel.deltaY * -256.0f));
+    }
+
+    /** ==================================================================== **/
+
+    void resized() override
+    {
+        cache = Image(
+            Image::PixelFormat::RGB,
+            jmax(1, getWidth()),
+            jmax(1, getHeight()),
+            false
+        );
+
+        renderIntoCache(getLocalBounds());
+    }
+
+    void paint(Graphics &g) override
+    {
+        g.drawImageAt(cache, 0, 0);
+
+        g.setColour(Colours::black.withAlpha(0.75f));
+        g.fillRect(getLocalBounds().removeFromBottom(25));
+
+        g.setColour(Colours::white);
+        g.setFont(14.0f);
+        g.drawText(
+            "Cache update: " + String(frameTime, 3) + "ms (click to pause)",
+            getLocalBounds().removeFromBottom(25).reduced(10, 0),
+            Justification::centredLeft
+        );
+    }
+};
+
+struct Demo : public Component
+{
+    List list;
+
+    Demo()
+    {
+        addAndMakeVisible(list);
+        setSize(500, 500);
+    }
+
+    void resized() override
+    {
+        list.setBounds(getLocalBounds());
+    }
+};
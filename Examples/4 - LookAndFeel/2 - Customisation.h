@@ -46,6 +46,153 @@
 
 #pragma once
 
+/** To find out where the time goes when painting, we can record how long each
+    paint() and LookAndFeel method takes.
+
+    Each thread writes its events into its own fixed-size ring buffer, so
+    recording an event never takes a lock or allocates memory. The events can
+    then be saved as a Chrome trace JSON file which can be opened with
+    chrome://tracing or https://ui.perfetto.dev to see each call on a timeline.
+**/
+struct Tracer
+{
+    static constexpr int BufferSize = 4096;
+
+    struct Event
+    {
+        const char *name = nullptr;
+        String componentName;
+        int64 startTicks = 0;
+        int64 endTicks   = 0;
+    };
+
+    /** Only the thread that owns a ThreadBuffer ever writes to it. **/
+    struct ThreadBuffer
+    {
+        Thread::ThreadID threadId = Thread::getCurrentThreadId();
+        Event events[BufferSize];
+        Atomic<int> numWritten { 0 };
+    };
+
+    bool isEnabled = true;
+
+    OwnedArray<ThreadBuffer> buffers;
+    SpinLock buffersLock;
+
+    static Tracer& getInstance()
+    {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    /** The first time a thread records an event it gets a ThreadBuffer of
+        its own. This is the only time we need to take a lock.
+    **/
+    ThreadBuffer& getBufferForThisThread()
+    {
+        thread_local ThreadBuffer *buffer = nullptr;
+
+        if (buffer == nullptr)
+        {
+            const SpinLock::ScopedLockType lock(buffersLock);
+            buffer = buffers.add(new ThreadBuffer());
+        }
+
+        return *buffer;
+    }
+
+    void addEvent(const Event &event)
+    {
+        ThreadBuffer &buffer = getBufferForThisThread();
+
+        const int index = buffer.numWritten.get();
+        buffer.events[index % BufferSize] = event;
+        buffer.numWritten = index + 1;
+    }
+
+    /** Writes the most recent events from every thread to a Chrome trace JSON
+        file. This should be called while nothing is being traced, e.g. from
+        the message thread in between paints.
+
+        https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+    **/
+    void saveChromeTrace(const File &file)
+    {
+        const SpinLock::ScopedLockType lock(buffersLock);
+
+        Array<var> traceEvents;
+
+        for (ThreadBuffer * const buffer : buffers)
+        {
+            const int numWritten = buffer->numWritten.get();
+
+            for (int i = jmax(0, numWritten - BufferSize); i < numWritten; ++i)
+            {
+                const Event &event = buffer->events[i % BufferSize];
+
+                DynamicObject::Ptr args = new DynamicObject();
+                args->setProperty("component", event.componentName);
+
+                DynamicObject::Ptr object = new DynamicObject();
+                object->setProperty("name", event.name);
+                object->setProperty("ph", "X");
+                object->setProperty("pid", 1);
+                object->setProperty(
+                    "tid",
+                    (int64)(pointer_sized_int)buffer->threadId
+                );
+                object->setProperty("ts", ticksToMicroseconds(event.startTicks));
+                object->setProperty(
+                    "dur",
+                    ticksToMicroseconds(event.endTicks - event.startTicks)
+                );
+                object->setProperty("args", var(args.get()));
+
+                traceEvents.add(var(object.get()));
+            }
+        }
+
+        DynamicObject::Ptr root = new DynamicObject();
+        root->setProperty("traceEvents", traceEvents);
+
+        file.replaceWithText(JSON::toString(var(root.get())));
+    }
+
+    static double ticksToMicroseconds(const int64 ticks)
+    {
+        return Time::highResolutionTicksToSeconds(ticks) * 1000000.0;
+    }
+};
+
+/** Records an event from the moment it is created until it goes out of scope.
+    The name must be a string literal, since only the pointer is stored.
+**/
+struct ScopedTrace
+{
+    Tracer::Event event;
+
+    ScopedTrace(const char *name, const Component &component)
+    {
+        if (Tracer::getInstance().isEnabled)
+        {
+            event.name = name;
+            event.componentName = component.getName();
+            event.startTicks = Time::getHighResolutionTicks();
+        }
+    }
+
+    ~ScopedTrace()
+    {
+        if (event.name != nullptr)
+        {
+            event.endTicks = Time::getHighResolutionTicks();
+            Tracer::getInstance().addEvent(event);
+        }
+    }
+};
+
+/** ======================================================================== **/
+
 /** Here we create a custom LookAndFeel by subclassing one of the default
     LookAndFeel types and overriding its virtual methods.
 **/
@@ -66,6 +213,427 @@ struct CustomLookAndFeel : public LookAndFeel_V4
         return Font().withHeight(DefaultFontSize).boldened();
     }
 
+    CustomLookAndFeel()
+    {
+        updatePalette();
+    }
+
+    /** ==================================================================== **/
+
+    /** Our drawing methods need the outline colour from the ColourScheme, and
+        brighter and darker versions of the button colours for the checkerboard
+        fill. Copying the ColourScheme and calling Colour::brighter() and
+        Colour::darker() (which convert to HSB and back) for every button on
+        every paint is wasted work, since the results only change when the
+        colours do.
+
+        Instead we work out all of these colours once, whenever the colours
+        change, and keep them in a flat array that our drawing methods can
+        simply index into.
+    **/
+    enum PaletteColour
+    {
+        paletteOutline,
+        paletteButton,
+        paletteButtonBrighter,
+        paletteButtonDarker,
+        paletteButtonOn,
+        paletteButtonOnBrighter,
+        paletteButtonOnDarker,
+
+        numPaletteColours
+    };
+
+    Colour palette[numPaletteColours];
+
+    void updatePalette()
+    {
+        const Colour button   = findColour(TextButton::buttonColourId);
+        const Colour buttonOn = findColour(TextButton::buttonOnColourId);
+
+        palette[paletteOutline] = getCurrentColourScheme()
+            .getUIColour(ColourScheme::outline);
+
+        palette[paletteButton]           = button;
+        palette[paletteButtonBrighter]   = button.brighter();
+        palette[paletteButtonDarker]     = button.darker();
+        palette[paletteButtonOn]         = buttonOn;
+        palette[paletteButtonOnBrighter] = buttonOn.brighter();
+        palette[paletteButtonOnDarker]   = buttonOn.darker();
+    }
+
+    /** A Button can be given its own colour using setColour(), so if the
+        colour we're given isn't one of the LookAndFeel's button colours we
+        still have to work out the brighter and darker versions on the spot.
+    **/
+    void getCheckerBoardColours(
+        const Colour &colour,
+        Colour &brighter,
+        Colour &darker) const
+    {
+        if (colour == palette[paletteButton])
+        {
+            brighter = palette[paletteButtonBrighter];
+            darker   = palette[paletteButtonDarker];
+        }
+        else if (colour == palette[paletteButtonOn])
+        {
+            brighter = palette[paletteButtonOnBrighter];
+            darker   = palette[paletteButtonOnDarker];
+        }
+        else
+        {
+            brighter = colour.brighter();
+            darker   = colour.darker();
+        }
+    }
+
+    /** Clipping to a Path means the Path has to be converted into an
+        EdgeTable every time, even if it's the same Path as last time. Every
+        button of the same size and colour draws exactly the same background,
+        so instead we draw each one into an Image once and keep it around.
+
+        The bounds passed in should be the button's local bounds, since the
+        cached Images always start at {0, 0}. The scale is the number of
+        physical pixels per logical pixel, so that the Images stay sharp on
+        high-DPI displays.
+
+        The outline colour comes from the palette, so coloursChanged() throws
+        the whole cache away. Buttons that are resized along with the window
+        would leave a new Image behind for every size they pass through, so
+        once the cache is full we simply start over.
+    **/
+    struct ButtonBackground
+    {
+        Rectangle<int> bounds;
+        Colour colour;
+        float scale = 1.0f;
+        Image image;
+    };
+
+    static constexpr int MaxButtonBackgrounds = 32;
+
+    HashMap<int64, ButtonBackground> buttonBackgrounds;
+
+    int buttonBackgroundHits   = 0;
+    int buttonBackgroundMisses = 0;
+
+    /** Called whenever the counters above change, so that whoever displays
+        them knows when to repaint.
+    **/
+    std::function<void()> onButtonBackgroundUsed;
+
+    const Image& getButtonBackground(
+        const Rectangle<int> &bounds,
+        const Colour &colour,
+        const float scale)
+    {
+        /** Different colours can end up with the same key, so the entry we
+            find still has to be checked before we use it.
+        **/
+        const int64 key = ((int64)bounds.getWidth() << 48)
+                        | ((int64)bounds.getHeight() << 32)
+                        | (int64)(colour.getARGB()
+                                  ^ (uint32)roundToInt(scale * 100.0f));
+
+        ButtonBackground *background = nullptr;
+
+        if (buttonBackgrounds.contains(key))
+            background = &buttonBackgrounds.getReference(key);
+
+        if (background != nullptr
+            && background->bounds == bounds
+            && background->colour == colour
+            && background->scale == scale)
+        {
+            ++buttonBackgroundHits;
+        }
+        else
+        {
+            ++buttonBackgroundMisses;
+
+            if (background == nullptr
+                && buttonBackgrounds.size() >= MaxButtonBackgrounds)
+                buttonBackgrounds.clear();
+
+            background = &buttonBackgrounds.getReference(key);
+            background->bounds = bounds;
+            background->colour = colour;
+            background->scale  = scale;
+            background->image  = drawButtonBackgroundImage(
+                bounds,
+                colour,
+                scale
+            );
+        }
+
+        if (onButtonBackgroundUsed != nullptr)
+            onButtonBackgroundUsed();
+
+        return background->image;
+    }
+
+    /** Here we use a checkerboard pattern to fill our button. Because our
+        button shape is rounded, we clip the Graphics context to our rounded
+        rectangle Path.
+    **/
+    Image drawButtonBackgroundImage(
+        const Rectangle<int> &bounds,
+        const Colour &colour,
+        const float scale)
+    {
+        Image image(
+            Image::ARGB,
+            jmax(1, roundToInt((float)bounds.getWidth() * scale)),
+            jmax(1, roundToInt((float)bounds.getHeight() * scale)),
+            true
+        );
+
+        Graphics g(image);
+        g.addTransform(AffineTransform::scale(scale));
+
+        Path path;
+        path.addRoundedRectangle(
+            bounds.reduced(DefaultOutlineSize),
+            DefaultCornerRadius
+        );
+
+        {
+            Graphics::ScopedSaveState saveState(g);
+            g.reduceClipRegion(path);
+
+            Colour brighter, darker;
+            getCheckerBoardColours(colour, brighter, darker);
+
+            g.fillCheckerBoard(path.getBounds(), 2.0f, 2.0f, brighter, darker);
+        }
+
+        g.setColour(palette[paletteOutline]);
+        g.strokePath(
+            path,
+            PathStrokeType(
+                DefaultOutlineSize,
+                PathStrokeType::JointStyle::curved,
+                PathStrokeType::EndCapStyle::rounded
+            )
+        );
+
+        return image;
+    }
+
+    /** ==================================================================== **/
+
+    /** Component::findColour() turns the colourId into an Identifier, looks
+        for it in the Component's own properties, then walks up the parents
+        to find the LookAndFeel in use and searches its colours. Unless you
+        pass inheritFromParent = true, the parents' own colours are never
+        checked. That is a lot of searching for a value that hardly ever
+        changes!
+
+        Here we remember the colours that each Component has already looked up.
+        Whenever a colour may have changed (e.g. setColour() was called or the
+        ColourScheme changed) coloursChanged() must be called, which bumps the
+        generation number so that every cached colour gets looked up again.
+
+        ColourIds are large, spread-out numbers, so each colour we cache is
+        given a slot of its own. Once a colour has been cached, looking it up
+        again is an index into that Component's array of slots.
+    **/
+    enum CachedColourSlot
+    {
+        slotTextOn,
+        slotTextOff,
+        slotToggleText,
+        slotTick,
+        slotTickDisabled,
+        slotLabelText,
+
+        numCachedColourSlots
+    };
+
+    static int getCachedColourSlot(const int colourId)
+    {
+        switch (colourId)
+        {
+            case TextButton::textColourOnId:         return slotTextOn;
+            case TextButton::textColourOffId:        return slotTextOff;
+            case ToggleButton::textColourId:         return slotToggleText;
+            case ToggleButton::tickColourId:         return slotTick;
+            case ToggleButton::tickDisabledColourId: return slotTickDisabled;
+            case Label::textColourId:                return slotLabelText;
+            default:                                 return -1;
+        }
+    }
+
+    struct CachedColours
+    {
+        Component::SafePointer<Component> component;
+        uint32 generation = 0;
+        uint32 validSlots = 0;
+
+        Colour colours[numCachedColourSlots];
+    };
+
+    HashMap<void*, CachedColours> cachedColours;
+    uint32 colourGeneration = 1;
+
+    /** The number of entries left after the last time deleted Components
+        were removed from the cache.
+    **/
+    int numCachedAfterCleanUp = 0;
+
+    void coloursChanged()
+    {
+        ++colourGeneration;
+        updatePalette();
+        removeDeletedComponents();
+        buttonBackgrounds.clear();
+    }
+
+    /** The cache is keyed by address, so entries for deleted Components would
+        stay around forever unless we remove them. A deleted Component's
+        SafePointer will have been cleared.
+    **/
+    void removeDeletedComponents()
+    {
+        Array<void*> deleted;
+
+        for (HashMap<void*, CachedColours>::Iterator i(cachedColours); i.next();)
+        {
+            if (i.getValue().component.getComponent() == nullptr)
+                deleted.add(i.getKey());
+        }
+
+        for (void * const key : deleted)
+            cachedColours.remove(key);
+
+        numCachedAfterCleanUp = cachedColours.size();
+    }
+
+    Colour findCachedColour(Component &component, const int colourId)
+    {
+        const int slot = getCachedColourSlot(colourId);
+
+        if (slot < 0)
+            return component.findColour(colourId);
+
+        /** Clean up whenever the cache has doubled in size, so the cost is
+            spread out over all the Components that were added.
+        **/
+        if (!cachedColours.contains(&component)
+            && cachedColours.size() >= jmax(16, numCachedAfterCleanUp * 2))
+            removeDeletedComponents();
+
+        CachedColours &cache = cachedColours.getReference(&component);
+
+        /** If a Component was deleted and a new one was created at the same
+            address, the SafePointer will have been cleared.
+        **/
+        if (cache.generation != colourGeneration
+            || cache.component.getComponent() != &component)
+        {
+            cache.component  = &component;
+            cache.generation = colourGeneration;
+            cache.validSlots = 0;
+        }
+
+        if ((cache.validSlots & (1u << slot)) == 0)
+        {
+            cache.colours[slot] = component.findColour(colourId);
+            cache.validSlots |= 1u << slot;
+        }
+
+        return cache.colours[slot];
+    }
+
+    /** ==================================================================== **/
+
+    /** sendLookAndFeelChange() makes every Component in the hierarchy update
+        and repaint itself, even if it doesn't use any of the colours that
+        changed.
+
+        Each time we draw a Component using a ColourScheme colour, we record it
+        in that Component's properties. The record is reset at the start of
+        each paint, so it only holds the colours used by the last paint. When
+        the ColourScheme changes we can skip any Components that don't use the
+        colours that changed.
+    **/
+    static const Identifier& getUsedColoursId()
+    {
+        static const Identifier usedColoursId("usedUIColours");
+        return usedColoursId;
+    }
+
+    /** Call this before anything else gets drawn in a Component's paint. **/
+    static void beginColourUse(Component &component)
+    {
+        component.getProperties().set(getUsedColoursId(), 0);
+    }
+
+    static void recordColourUse(Component &component, const int colours)
+    {
+        NamedValueSet &properties = component.getProperties();
+
+        const int usedColours = properties[getUsedColoursId()];
+        properties.set(getUsedColoursId(), usedColours | colours);
+    }
+
+    static void recordColourUse(
+        Component &component,
+        const ColourScheme::UIColour colour)
+    {
+        recordColourUse(component, 1 << (int)colour);
+    }
+
+    /** LookAndFeel_V4 sets each of its ColourIds from one of the ColourScheme
+        colours. This returns the ColourScheme colours a ColourId depends on,
+        as a bitmask. If we don't know, we assume it could depend on any.
+    **/
+    static int getUIColoursForId(const int colourId)
+    {
+        switch (colourId)
+        {
+            case TextButton::buttonColourId:
+                return 1 << ColourScheme::widgetBackground;
+
+            case TextButton::buttonOnColourId:
+                return 1 << ColourScheme::highlightedFill;
+
+            case TextButton::textColourOnId:
+                return 1 << ColourScheme::highlightedText;
+
+            case TextButton::textColourOffId:
+            case ToggleButton::textColourId:
+            case ToggleButton::tickColourId:
+            case ToggleButton::tickDisabledColourId:
+            case Label::textColourId:
+                return 1 << ColourScheme::defaultText;
+
+            case ResizableWindow::backgroundColourId:
+                return 1 << ColourScheme::windowBackground;
+
+            default:
+                return ~0;
+        }
+    }
+
+    static void recordColourIdUse(Component &component, const int colourId)
+    {
+        recordColourUse(component, getUIColoursForId(colourId));
+    }
+
+    /** Takes a bitmask of UIColours. If we have never drawn the Component we
+        don't know which colours it uses, so we assume it could use any.
+    **/
+    static bool usesAnyColour(Component &component, const int colours)
+    {
+        const var * const usedColours = component
+            .getProperties()
+            .getVarPointer(getUsedColoursId());
+
+        return usedColours == nullptr || ((int)*usedColours & colours) != 0;
+    }
+
     /** Many widgets have their "pieces" broken up so that you can easily alter
         the style without having to re-write an entire drawing routine. For
         example getTextButtonFont() is used by the default LookAndFeel
@@ -91,6 +659,21 @@ struct CustomLookAndFeel : public LookAndFeel_V4
         const bool shouldDrawButtonAsHighlighted,
         const bool shouldDrawButtonAsDown) override
     {
+        ScopedTrace trace("drawButtonBackground", button);
+
+        /** TextButton::paintButton() draws the background first, so this is
+            where its paint starts. The background colour it passes us is the
+            button's "on" colour when the button is toggled on.
+        **/
+        beginColourUse(button);
+        recordColourIdUse(
+            button,
+            button.getToggleState()
+                ? TextButton::buttonOnColourId
+                : TextButton::buttonColourId
+        );
+        recordColourUse(button, ColourScheme::outline);
+
         /** You can often use the LookAndFeels to manage things like the
             Component's MouseCursor without having to subclass the Component
             type.
@@ -98,46 +681,21 @@ struct CustomLookAndFeel : public LookAndFeel_V4
         if (shouldDrawButtonAsHighlighted || shouldDrawButtonAsDown)
             button.setMouseCursor(MouseCursor::PointingHandCursor);
 
-        const ColourScheme   scheme(getCurrentColourScheme());
-        const Rectangle<int> bounds(button.getLocalBounds());
-
-        if (!button.isEnabled())
-            g.beginTransparencyLayer(DisabledTransparency);
+        const float scale =
+            g.getInternalContext().getPhysicalPixelScaleFactor();
 
-        Path path;
-        path.addRoundedRectangle(
-            bounds.reduced(DefaultOutlineSize),
-            DefaultCornerRadius
+        const Image &image = getButtonBackground(
+            button.getLocalBounds(),
+            backgroundColour,
+            scale
         );
 
-        /** Here we use a checkerboard pattern to fill our button. Because our
-            button shape is rounded, we clip the Graphics context to our
-            rounded rectangle Path.
+        /** The whole background is a single Image now, so a disabled button
+            can simply draw it with less opacity instead of needing its own
+            transparency layer.
         **/
-        {
-            Graphics::ScopedSaveState saveState(g);
-            g.reduceClipRegion(path);
-
-            g.fillCheckerBoard(
-                path.getBounds(),
-                2.0f, 2.0f,
-                backgroundColour.brighter(),
-                backgroundColour.darker()
-            );
-        }
-
-        g.setColour(scheme.getUIColour(ColourScheme::outline));
-        g.strokePath(
-            path,
-            PathStrokeType(
-                DefaultOutlineSize,
-                PathStrokeType::JointStyle::curved,
-                PathStrokeType::EndCapStyle::rounded
-            )
-        );
-
-        if (!button.isEnabled())
-            g.endTransparencyLayer();
+        g.setOpacity(button.isEnabled() ? 1.0f : DisabledTransparency);
+        g.drawImageTransformed(image, AffineTransform::scale(1.0f / scale));
     }
 
     /** This method handles drawing a TextButton's text. It is called from the
@@ -149,10 +707,14 @@ struct CustomLookAndFeel : public LookAndFeel_V4
         const bool shouldDrawButtonAsHighlighted,
         const bool shouldDrawButtonAsDown) override
     {
-        if (shouldDrawButtonAsDown)
-            g.setColour(button.findColour(TextButton::textColourOnId));
-        else
-            g.setColour(button.findColour(TextButton::textColourOffId));
+        ScopedTrace trace("drawButtonText", button);
+
+        const int textColourId = (shouldDrawButtonAsDown)
+            ? TextButton::textColourOnId
+            : TextButton::textColourOffId;
+
+        recordColourIdUse(button, textColourId);
+        g.setColour(findCachedColour(button, textColourId));
 
         if (!button.isEnabled())
             g.setOpacity(DisabledTransparency);
@@ -178,6 +740,11 @@ struct CustomLookAndFeel : public LookAndFeel_V4
         const bool shouldDrawButtonAsHighlighted,
         const bool shouldDrawButtonAsDown) override
     {
+        ScopedTrace trace("drawToggleButton", button);
+
+        beginColourUse(button);
+        recordColourIdUse(button, ToggleButton::textColourId);
+
         if (shouldDrawButtonAsHighlighted || shouldDrawButtonAsDown)
             button.setMouseCursor(MouseCursor::PointingHandCursor);
 
@@ -207,7 +774,7 @@ struct CustomLookAndFeel : public LookAndFeel_V4
             shouldDrawButtonAsDown
         );
 
-        g.setColour(button.findColour(ToggleButton::textColourId));
+        g.setColour(findCachedColour(button, ToggleButton::textColourId));
         g.setFont(font.withHeight(fontSize));
 
         if (!button.isEnabled())
@@ -235,7 +802,10 @@ struct CustomLookAndFeel : public LookAndFeel_V4
         const bool shouldDrawButtonAsHighlighted,
         const bool shouldDrawButtonAsDown) override
     {
-        const ColourScheme     scheme(getCurrentColourScheme());
+        ScopedTrace trace("drawTickBox", component);
+
+        recordColourUse(component, ColourScheme::outline);
+
         const Rectangle<float> bounds(x, y, width, height);
 
         if (!isEnabled)
@@ -249,7 +819,7 @@ struct CustomLookAndFeel : public LookAndFeel_V4
                 DefaultCornerRadius
             );
 
-            g.setColour(scheme.getUIColour(ColourScheme::outline));
+            g.setColour(palette[paletteOutline]);
 
             g.strokePath(
                 path,
@@ -281,8 +851,12 @@ struct CustomLookAndFeel : public LookAndFeel_V4
                 itself. This gives you the flexibility to change a given colour
                 for a specific Component, rather than the colour only being
                 derived from the LookAndFeel's colours.
+
+                We use our cached version of findColour() here, which gives the
+                same result without searching through the hierarchy each time.
             **/
-            g.setColour(component.findColour(tickColourId));
+            recordColourIdUse(component, tickColourId);
+            g.setColour(findCachedColour(component, tickColourId));
             g.fillPath(path);
         }
 
@@ -304,11 +878,24 @@ struct Demo : public Component
     TextButton   textButton;
     ToggleButton toggleButton;
     ComboBox     comboBox;
+    TextButton   saveTraceButton;
 
     CustomLookAndFeel customLookAndFeel;
 
+    int numSkippedUpdates = 0;
+
     Demo()
     {
+        /** Giving each Component a name lets us tell them apart in the trace.
+        **/
+        setName("Demo");
+        textButton.setName("Enablement Button");
+        toggleButton.setName("Custom L&F Toggle");
+        comboBox.setName("Colour Scheme Box");
+        saveTraceButton.setName("Save Trace Button");
+
+        /** ================================================================ **/
+
         textButton.setButtonText("Toggle Enablement");
         textButton.setToggleState(true, dontSendNotification);
         textButton.setBounds(150, 150, 200, 25);
@@ -335,30 +922,66 @@ struct Demo : public Component
         };
         addAndMakeVisible(toggleButton);
 
+        /** Hovering over a button only repaints the area behind that button,
+            so our counters at the bottom need repainting whenever they change.
+            They don't overlap any of the buttons, so this won't make the
+            buttons paint again.
+        **/
+        customLookAndFeel.onButtonBackgroundUsed = [this]() -> void
+        {
+            repaint(getLocalBounds().removeFromBottom(50));
+        };
+
         /** ================================================================ **/
 
-        comboBox.addItemList({"Dark", "Grey", "Light", "Midnight"}, 1);
+        comboBox.addItemList(
+            {"Dark", "Grey", "Light", "Midnight", "Dark (Purple Highlight)"},
+            1
+        );
         comboBox.onChange = [this]() -> void
         {
-            static const LookAndFeel_V4::ColourScheme schemes[4] = {
+            static const LookAndFeel_V4::ColourScheme schemes[5] = {
                 LookAndFeel_V4::getDarkColourScheme(),
                 LookAndFeel_V4::getGreyColourScheme(),
                 LookAndFeel_V4::getLightColourScheme(),
-                LookAndFeel_V4::getMidnightColourScheme()
+                LookAndFeel_V4::getMidnightColourScheme(),
+                getDarkPurpleColourScheme()
             };
 
             if (auto * const lf = dynamic_cast<LookAndFeel_V4*>(&getLookAndFeel()))
             {
+                const LookAndFeel_V4::ColourScheme oldScheme(
+                    lf->getCurrentColourScheme()
+                );
+
                 lf->setColourScheme(schemes[comboBox.getSelectedId() - 1]);
 
+                /** The ColourScheme changes most of the LookAndFeel's colours,
+                    so any colours that were cached are now out of date.
+                **/
+                customLookAndFeel.coloursChanged();
+
                 /** Normally setting a LookAndFeel for a Component will trigger
                     this call and all of its children will be updated... but
                     when you're keeping the same LookAndFeel and only updating
                     one of its values or something similar, you will need to
                     make sure the top level component using the LookAndFeel
                     sends this change message.
+
+                    With our custom LookAndFeel we know which colours each
+                    Component has used, so we can be more selective.
                 **/
-                sendLookAndFeelChange();
+                if (lf == &customLookAndFeel)
+                {
+                    sendLookAndFeelChangeForColours(
+                        oldScheme,
+                        lf->getCurrentColourScheme()
+                    );
+                }
+                else
+                {
+                    sendLookAndFeelChange();
+                }
             }
         };
         comboBox.setBounds(150, 250, 200, 25);
@@ -367,9 +990,72 @@ struct Demo : public Component
 
         /** ================================================================ **/
 
+        /** Move the mouse over the buttons and switch a few ColourSchemes,
+            then save the trace and open it in chrome://tracing to see how
+            long each paint and LookAndFeel method took.
+        **/
+        saveTraceButton.setButtonText("Save Trace To Desktop");
+        saveTraceButton.setBounds(150, 300, 200, 25);
+        saveTraceButton.onClick = []() -> void
+        {
+            Tracer::getInstance().saveChromeTrace(
+                File::getSpecialLocation(File::userDesktopDirectory)
+                    .getChildFile("trace.json")
+            );
+        };
+        addAndMakeVisible(saveTraceButton);
+
+        /** ================================================================ **/
+
+        #if 0 // change to 1 to time colour lookups in a deep hierarchy
+          timeColourLookups();
+        #endif
+
         setSize(500, 500);
     }
 
+    /** Looks up a colour from a LookAndFeel that is only set on the top of a
+        20-deep hierarchy, 1,000,000 times with findColour() and then with
+        findCachedColour(), and logs how long each took.
+    **/
+    void timeColourLookups()
+    {
+        OwnedArray<Component> hierarchy;
+        hierarchy.add(new Component());
+        hierarchy[0]->setLookAndFeel(&customLookAndFeel);
+
+        for (int i = 1; i < 20; ++i)
+        {
+            hierarchy.add(new Component());
+            hierarchy[i - 1]->addChildComponent(hierarchy[i]);
+        }
+
+        Component &deepest = *hierarchy.getLast();
+        const int numIterations = 1000000;
+
+        uint32 checksum = 0;
+        double startTime = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numIterations; ++i)
+            checksum += deepest.findColour(Label::textColourId).getARGB();
+
+        Logger::writeToLog("findColour(): "
+            + String(Time::getMillisecondCounterHiRes() - startTime, 2) + "ms");
+
+        startTime = Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < numIterations; ++i)
+        {
+            checksum += customLookAndFeel
+                .findCachedColour(deepest, Label::textColourId)
+                .getARGB();
+        }
+
+        Logger::writeToLog("findCachedColour(): "
+            + String(Time::getMillisecondCounterHiRes() - startTime, 2) + "ms"
+            + " (checksum " + String(checksum) + ")");
+    }
+
     /** ==================================================================== **/
 
     ~Demo()
@@ -379,12 +1065,74 @@ struct Demo : public Component
 
     /** ==================================================================== **/
 
+    /** The same as the Dark ColourScheme, but with a different highlight
+        colour. Only the "Toggle Enablement" button uses the highlight colour,
+        because it is toggled on, so switching between this and the Dark scheme
+        lets the other buttons skip their updates.
+    **/
+    static LookAndFeel_V4::ColourScheme getDarkPurpleColourScheme()
+    {
+        LookAndFeel_V4::ColourScheme scheme(
+            LookAndFeel_V4::getDarkColourScheme()
+        );
+
+        scheme.setUIColour(
+            LookAndFeel_V4::ColourScheme::highlightedFill,
+            Colours::purple
+        );
+
+        return scheme;
+    }
+
+    /** Sends a LookAndFeel change only to the children that use one of the
+        colours that differ between the two ColourSchemes.
+    **/
+    void sendLookAndFeelChangeForColours(
+        const LookAndFeel_V4::ColourScheme &oldScheme,
+        const LookAndFeel_V4::ColourScheme &newScheme)
+    {
+        using ColourScheme = LookAndFeel_V4::ColourScheme;
+
+        int changedColours = 0;
+
+        for (int i = 0; i < ColourScheme::numColours; ++i)
+        {
+            const ColourScheme::UIColour colour = (ColourScheme::UIColour)i;
+
+            if (oldScheme.getUIColour(colour) != newScheme.getUIColour(colour))
+                changedColours |= 1 << i;
+        }
+
+        /** Repainting the Demo will repaint all of its children too, so if
+            the Demo needs updating we may as well update everything.
+        **/
+        if (CustomLookAndFeel::usesAnyColour(*this, changedColours))
+        {
+            sendLookAndFeelChange();
+            return;
+        }
+
+        for (Component * const child : getChildren())
+        {
+            if (CustomLookAndFeel::usesAnyColour(*child, changedColours))
+                child->sendLookAndFeelChange();
+            else
+                ++numSkippedUpdates;
+        }
+
+        repaint(getLocalBounds().removeFromBottom(50));
+    }
+
+    /** ==================================================================== **/
+
     /** We can use the new ColourScheme features that are present in JUCE's
         LookAndFeel_V4 to grab the ColourScheme colours for certain generic
         attributes, such as the default window background colour.
     **/
     void paint(Graphics &g)
     {
+        ScopedTrace trace("paint", *this);
+
         using ColourScheme = LookAndFeel_V4::ColourScheme;
 
         if (auto * const lf = dynamic_cast<LookAndFeel_V4*>(&getLookAndFeel()))
@@ -392,6 +1140,28 @@ struct Demo : public Component
             const ColourScheme scheme = lf->getCurrentColourScheme();
             g.fillAll(scheme.getUIColour(ColourScheme::windowBackground));
         }
+
+        CustomLookAndFeel::beginColourUse(*this);
+        CustomLookAndFeel::recordColourUse(*this, ColourScheme::windowBackground);
+        CustomLookAndFeel::recordColourIdUse(*this, Label::textColourId);
+
+        /** Hover over the buttons with the custom LookAndFeel enabled to see
+            how often the cached button backgrounds get re-used, and switch
+            between the Dark ColourSchemes to see Components skip their
+            updates.
+        **/
+        g.setColour(findColour(Label::textColourId));
+        g.setFont(12.0f);
+        g.drawFittedText(
+            "Button background cache: "
+                + String(customLookAndFeel.buttonBackgroundHits) + " hits, "
+                + String(customLookAndFeel.buttonBackgroundMisses) + " misses\n"
+                + "LookAndFeel updates skipped: "
+                + String(numSkippedUpdates),
+            getLocalBounds().reduced(10),
+            Justification::bottomLeft,
+            2
+        );
     }
 };
 
@@ -0,0 +1,254 @@
+/*******************************************************************************
+ The block below describes the properties of this PIP. A PIP is a short snippet
+ of code that can be read by the Projucer and used to generate a JUCE project.
+
+ BEGIN_JUCE_PIP_METADATA
+
+  name:             Parallel Layout
+  vendor:           Antonio Lassandro
+  website:          https://www.github.com/lassandroan/juce-graphics-workshop
+  description:      Computing the layout of independent subtrees in parallel
+
+  dependencies:     juce_core, juce_gui_basics
+  exporters:        linux_make, vs2013, vs2015, vs2017, vs2019, xcode_mac
+
+  moduleFlags:      JUCE_STRICT_REFCOUNTEDPOINTER=1
+
+  type:             Component
+  mainClass:        Demo
+
+ END_JUCE_PIP_METADATA
+
+*******************************************************************************/
+
+/*
+  Author: Antonio Lassandro
+  Copyright 2019 Harrison Consoles
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+/** A Container is a plain Component that holds nested children. It doesn't
+    lay out its children in resized() - the Demo computes the bounds for every
+    Container up front and applies them all in one pass.
+**/
+struct Container : public Component
+{
+    Colour colour;
+
+    void paint(Graphics &g) override
+    {
+        g.setColour(colour);
+        g.drawRect(getLocalBounds());
+    }
+};
+
+/** A LayoutNode mirrors one Container in the hierarchy, but only holds
+    geometry. Because computing a layout never touches a Component, sibling
+    subtrees don't depend on each other and can be laid out on any thread.
+
+    Only the final setBounds() calls need to happen on the message thread.
+**/
+struct LayoutNode
+{
+    Component *component = nullptr;
+    Rectangle<int> bounds;
+    bool isRow = true;
+
+    OwnedArray<LayoutNode> children;
+
+    /** Sets the bounds of our direct children using our own bounds. **/
+    void place()
+    {
+        if (children.isEmpty())
+            return;
+
+        FlexBox flexbox;
+        flexbox.flexDirection = isRow
+            ? FlexBox::Direction::row
+            : FlexBox::Direction::column;
+
+        /** FlexItems don't need an associatedComponent. When performLayout()
+            is finished, each item's currentBounds holds the result and we can
+            do whatever we want with it.
+        **/
+        for (int i = 0; i < children.size(); ++i)
+        {
+            FlexItem flexItem;
+            flexItem.flexGrow = 1.0f;
+            flexItem.margin = FlexItem::Margin(1.0f);
+
+            flexbox.items.add(flexItem);
+        }
+
+        /** Child bounds are relative to their parent, so we lay out inside
+            our bounds with a position of {0, 0}.
+        **/
+        flexbox.performLayout(bounds.withZeroOrigin());
+
+        for (int i = 0; i < children.size(); ++i)
+        {
+            children[i]->bounds = flexbox.items[i]
+                .currentBounds
+                .getSmallestIntegerContainer();
+        }
+    }
+
+    /** Places our children and then all of their descendants. **/
+    void layout()
+    {
+        place();
+
+        for (LayoutNode * const child : children)
+            child->layout();
+    }
+
+    /** Copies the computed bounds into the Components. Message thread only! **/
+    void apply() const
+    {
+        component->setBounds(bounds);
+
+        for (LayoutNode * const child : children)
+            child->apply();
+    }
+};
+
+struct Demo : public Component
+{
+    static constexpr int NumSubtrees  = 4;
+    static constexpr int NumBranches  = 4;
+    static constexpr int SubtreeDepth = 5;
+
+    OwnedArray<Container> containers;
+    LayoutNode root;
+
+    ThreadPool threadPool { SystemStats::getNumCpus() };
+
+    double layoutTime = 0.0;
+
+    Demo()
+    {
+        root.component = this;
+
+        build(root, *this, NumSubtrees, SubtreeDepth + 1);
+
+        setSize(500, 500);
+    }
+
+    /** Creates the given number of children for a node, alternating between
+        rows and columns at each level of the tree.
+    **/
+    void build(
+        LayoutNode &node,
+        Component &parent,
+        const int numChildren,
+        const int depth)
+    {
+        for (int i = 0; i < numChildren; ++i)
+        {
+            Container * const container = containers.add(new Container());
+            container->colour = Colour::fromHSV(
+                (float)i / numChildren, 0.5f, 0.9f, 1.0f
+            );
+            parent.addAndMakeVisible(container);
+
+            LayoutNode * const child = node.children.add(new LayoutNode());
+            child->component = container;
+            child->isRow = !node.isRow;
+
+            if (depth > 1)
+                build(*child, *container, NumBranches, depth - 1);
+        }
+    }
+
+    /** ==================================================================== **/
+
+    /** Normally each Container would lay out its own children in resized(),
+        which would trigger its children's resized() calls, and so on down the
+        entire tree - all of it happening serially on the message thread.
+
+        Here we split the work into three steps:
+
+            1. Place the top-level subtrees (cheap, on the message thread)
+            2. Lay out each subtree as its own ThreadPool job
+            3. Apply every computed bound on the message thread in one batch
+
+        https://docs.juce.com/master/classThreadPool.html
+    **/
+    void resized() override
+    {
+        const double startTime = Time::getMillisecondCounterHiRes();
+
+        root.bounds = getLocalBounds();
+        root.place();
+
+        #if 1 // change to 0 to lay out every subtree on the message thread
+          WaitableEvent finished;
+          Atomic<int> remaining(root.children.size());
+
+          for (LayoutNode * const subtree : root.children)
+          {
+              threadPool.addJob([subtree, &remaining, &finished]() -> void
+              {
+                  subtree->layout();
+
+                  if (--remaining == 0)
+                      finished.signal();
+              });
+          }
+
+          finished.wait();
+        #else
+          for (LayoutNode * const subtree : root.children)
+              subtree->layout();
+        #endif
+
+        /** The root's bounds are set by our parent window, so we only need to
+            apply the bounds for each subtree.
+        **/
+        for (LayoutNode * const subtree : root.children)
+            subtree->apply();
+
+        layoutTime = Time::getMillisecondCounterHiRes() - startTime;
+    }
+
+    /** ==================================================================== **/
+
+    void paint(Graphics &g) override
+    {
+        g.fillAll(findColour(ResizableWindow::backgroundColourId));
+    }
+
+    /** Try resizing the window and compare the layout time with and without
+        the ThreadPool.
+    **/
+    void paintOverChildren(Graphics &g) override
+    {
+        g.setColour(Colours::white);
+        g.setFont(24.0f);
+        g.drawText(
+            String(containers.size()) + " containers laid out in "
+                + String(layoutTime, 2) + "ms",
+            getLocalBounds(),
+            Justification::centred
+        );
+    }
+};
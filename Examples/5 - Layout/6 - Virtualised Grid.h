@@ -0,0 +1,308 @@
+/*******************************************************************************
+ The block below describes the properties of this PIP. A PIP is a short snippet
+ of code that can be read by the Projucer and used to generate a JUCE project.
+
+ BEGIN_JUCE_PIP_METADATA
+
+  name:             Virtualised Grid
+  vendor:           Antonio Lassandro
+  website:          https://www.github.com/lassandroan/juce-graphics-workshop
+  description:      Only creates components for the visible cells of a grid
+
+  dependencies:     juce_core, juce_gui_basics
+  exporters:        linux_make, vs2013, vs2015, vs2017, vs2019, xcode_mac
+
+  moduleFlags:      JUCE_STRICT_REFCOUNTEDPOINTER=1
+
+  type:             Component
+  mainClass:        Demo
+
+ END_JUCE_PIP_METADATA
+
+*******************************************************************************/
+
+/*
+  Author: Antonio Lassandro
+  Copyright 2019 Harrison Consoles
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#pragma once
+
+struct Cell : public Component
+{
+    int row    = 0;
+    int column = 0;
+
+    void paint(Graphics &g) override
+    {
+        g.fillAll(
+            Colour::fromHSV(
+                (float)((row + column) % 32) / 32.0f, 0.4f, 0.9f, 1.0f
+            )
+        );
+
+        g.setColour(Colours::black);
+        g.setFont(12.0f);
+        g.drawText(
+            String(row) + ", " + String(column),
+            getLocalBounds(),
+            Justification::centred
+        );
+    }
+};
+
+/** A Viewport that only creates Components for the cells it can see.
+
+    A Grid needs a GridItem (and usually a Component) for every cell, and its
+    performLayout() has to look at every one of them. With fixed size tracks
+    we don't need any of that - the bounds of any cell can be worked out with
+    a multiplication, and the size of the whole grid is known up front.
+
+    When the view moves, cells that have scrolled out of view go back into a
+    pool and are reused for the cells that have scrolled in. The number of
+    Components stays the same no matter how many cells the grid has, so
+    scrolling costs the same for a thousand cells as for a million.
+**/
+struct VirtualGrid : public Viewport
+{
+    static constexpr int CellWidth  = 80;
+    static constexpr int CellHeight = 30;
+
+    Component content;
+
+    OwnedArray<Cell> cells;
+    HashMap<int, Cell*> visibleCells;
+    Array<Cell*> spareCells;
+
+    int numRows    = 0;
+    int numColumns = 0;
+
+    double frameTime = 0.0;
+
+    VirtualGrid()
+    {
+        setViewedComponent(&content, false);
+    }
+
+    void setGridSize(const int rows, const int columns)
+    {
+        numRows    = rows;
+        numColumns = columns;
+
+        /** Component bounds are ints, so the total size has to stay below
+            2^31 pixels in each direction.
+        **/
+        content.setSize(numColumns * CellWidth, numRows * CellHeight);
+    }
+
+    Rectangle<int> getCellBounds(const int row, const int column) const
+    {
+        return {column * CellWidth, row * CellHeight, CellWidth, CellHeight};
+    }
+
+    /** ==================================================================== **/
+
+    /** Called by the Viewport whenever the view is scrolled or resized. **/
+    void visibleAreaChanged(const Rectangle<int> &area) override
+    {
+        const double startTime = Time::getMillisecondCounterHiRes();
+
+        const int firstRow    = jmax(0, area.getY() / CellHeight);
+        const int firstColumn = jmax(0, area.getX() / CellWidth);
+
+        const int lastRow = jmin(
+            numRows - 1,
+            (area.getBottom() - 1) / CellHeight
+        );
+
+        const int lastColumn = jmin(
+            numColumns - 1,
+            (area.getRight() - 1) / CellWidth
+        );
+
+        /** Return the cells that are no longer visible to the pool. They stay
+            children of the content, so there's no need to remove them.
+        **/
+        Array<int> hiddenCells;
+
+        for (HashMap<int, Cell*>::Iterator i(visibleCells); i.next();)
+        {
+            Cell * const cell = i.getValue();
+
+            if (cell->row < firstRow || cell->row > lastRow
+                || cell->column < firstColumn || cell->column > lastColumn)
+            {
+                cell->setVisible(false);
+                spareCells.add(cell);
+                hiddenCells.add(i.getKey());
+            }
+        }
+
+        for (const int key : hiddenCells)
+            visibleCells.remove(key);
+
+        /** Fill in the cells that have scrolled into view. **/
+        for (int row = firstRow; row <= lastRow; ++row)
+        {
+            for (int column = firstColumn; column <= lastColumn; ++column)
+            {
+                const int key = row * numColumns + column;
+
+                if (visibleCells.contains(key))
+                    continue;
+
+                Cell *cell = spareCells.removeAndReturn(spareCells.size() - 1);
+
+                if (cell == nullptr)
+                {
+                    cell = cells.add(new Cell());
+                    content.addChildComponent(cell);
+                }
+
+                cell->row    = row;
+                cell->column = column;
+                cell->setBounds(getCellBounds(row, column));
+                cell->setVisible(true);
+                cell->repaint();
+
+                visibleCells.set(key, cell);
+            }
+        }
+
+        frameTime = Time::getMillisecondCounterHiRes() - startTime;
+    }
+};
+
+/** The same grid, but with a Component for every cell laid out by a Grid.
+
+    Only try this with the smaller cell counts!
+**/
+struct FullGrid : public Viewport
+{
+    Component content;
+    OwnedArray<Cell> cells;
+
+    /** Every cell already exists, so there's nothing to update on scroll. **/
+    double frameTime = 0.0;
+
+    FullGrid()
+    {
+        setViewedComponent(&content, false);
+    }
+
+    void setGridSize(const int rows, const int columns)
+    {
+        Grid grid;
+        grid.autoRows    = Grid::TrackInfo(Grid::Px(VirtualGrid::CellHeight));
+        grid.autoColumns = Grid::TrackInfo(Grid::Px(VirtualGrid::CellWidth));
+
+        for (int i = 0; i < columns; ++i)
+            grid.templateColumns.add(grid.autoColumns);
+
+        for (int row = 0; row < rows; ++row)
+        {
+            for (int column = 0; column < columns; ++column)
+            {
+                Cell * const cell = cells.add(new Cell());
+                cell->row    = row;
+                cell->column = column;
+                content.addAndMakeVisible(cell);
+
+                grid.items.add(GridItem(cell));
+            }
+        }
+
+        content.setSize(
+            columns * VirtualGrid::CellWidth,
+            rows * VirtualGrid::CellHeight
+        );
+
+        grid.performLayout(content.getLocalBounds());
+    }
+};
+
+struct Demo : public Component, public Timer
+{
+    /** Try changing this between 10^3 and 10^6 and compare the frame times. **/
+    static constexpr int NumCells   = 1000000;
+    static constexpr int NumColumns = 100;
+
+    #if 1 // change to 0 to create a Component for every cell
+      VirtualGrid grid;
+    #else
+      FullGrid grid;
+    #endif
+
+    double frameTime = 0.0;
+
+    Demo()
+    {
+        grid.setGridSize(NumCells / NumColumns, NumColumns);
+        addAndMakeVisible(grid);
+
+        setSize(500, 500);
+        startTimerHz(60);
+    }
+
+    /** ==================================================================== **/
+
+    /** Scrolls diagonally through the grid, timing everything the Viewport
+        does in response to moving the view.
+    **/
+    void timerCallback() override
+    {
+        const Point<int> position = grid.getViewPosition();
+        const Component &content = *grid.getViewedComponent();
+
+        const double startTime = Time::getMillisecondCounterHiRes();
+
+        if (position.y + grid.getViewHeight() >= content.getHeight())
+            grid.setViewPosition(0, 0);
+        else
+            grid.setViewPosition(position + Point<int>(1, 3));
+
+        frameTime = Time::getMillisecondCounterHiRes() - startTime;
+
+        repaint(getLocalBounds().removeFromBottom(25));
+    }
+
+    /** ==================================================================== **/
+
+    void resized() override
+    {
+        grid.setBounds(getLocalBounds());
+    }
+
+    void paintOverChildren(Graphics &g) override
+    {
+        g.setColour(Colours::black.withAlpha(0.75f));
+        g.fillRect(getLocalBounds().removeFromBottom(25));
+
+        g.setColour(Colours::white);
+        g.setFont(14.0f);
+        g.drawText(
+            String(NumCells) + " cells, scroll: " + String(frameTime, 3)
+                + "ms, cell update: " + String(grid.frameTime, 3) + "ms",
+            getLocalBounds().removeFromBottom(25).reduced(10, 0),
+            Justification::centredLeft
+        );
+    }
+};